@@ -0,0 +1,26 @@
+"""
+Generates a party with many top-level declarations to benchmark module tree building and name resolution.
+
+Usage:
+    python3 bench/gen_decls.py [count] [output dir]
+    Jacy <output dir>/main.jc -benchmark=each-stage
+
+Defaults are 100000 functions in `bench_decls` directory.
+"""
+
+import os
+import sys
+
+
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+    out_dir = sys.argv[2] if len(sys.argv) > 2 else 'bench_decls'
+
+    os.makedirs(out_dir, exist_ok=True)
+    with open(os.path.join(out_dir, 'main.jc'), 'w') as file:
+        for i in range(count):
+            file.write('func f{}(a: int) {{ a }}\n'.format(i))
+
+
+if __name__ == '__main__':
+    main()
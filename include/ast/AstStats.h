@@ -0,0 +1,184 @@
+#ifndef JACY_AST_ASTSTATS_H
+#define JACY_AST_ASTSTATS_H
+
+#include "ast/StubVisitor.h"
+#include "session/Session.h"
+
+namespace jc::ast {
+    /// AstStats
+    /// @brief Debug visitor reporting memory and shape of the AST (`--print ast-stats`, `--print ast-stats-json`)
+    /// Node bytes include `make_shared` control block and capacity of vectors owned by node,
+    ///  shape is reported per `FileModule` as max depth and average fan-out of non-leaf nodes.
+    class AstStats : public StubVisitor {
+    public:
+        AstStats();
+
+        void addTokens(const parser::token_list & tokens);
+        void collect(const sess::sess_ptr & sess, const Party & party);
+        void print();
+        void printJson();
+
+        void visit(const ErrorNode & errorNode) override;
+        void visit(const File & file) override;
+        void visit(const FileModule & fileModule) override;
+
+        // Items //
+        void visit(const Enum & enumDecl) override;
+        void visit(const EnumEntry & enumEntry) override;
+        void visit(const Func & func) override;
+        void visit(const FuncParam & funcParam) override;
+        void visit(const Impl & impl) override;
+        void visit(const Mod & mod) override;
+        void visit(const Struct & _struct) override;
+        void visit(const StructField & field) override;
+        void visit(const Trait & trait) override;
+        void visit(const TypeAlias & typeAlias) override;
+        void visit(const UseDecl & useDecl) override;
+        void visit(const UseTreeRaw & useTree) override;
+        void visit(const UseTreeSpecific & useTree) override;
+        void visit(const UseTreeRebind & useTree) override;
+        void visit(const UseTreeAll & useTree) override;
+
+        // Statements //
+        void visit(const ExprStmt & exprStmt) override;
+        void visit(const ForStmt & forStmt) override;
+        void visit(const ItemStmt & itemStmt) override;
+        void visit(const VarStmt & varStmt) override;
+        void visit(const WhileStmt & whileStmt) override;
+
+        // Expressions //
+        void visit(const Assignment & assign) override;
+        void visit(const Block & block) override;
+        void visit(const BorrowExpr & borrowExpr) override;
+        void visit(const BreakExpr & breakExpr) override;
+        void visit(const ContinueExpr & continueExpr) override;
+        void visit(const DerefExpr & derefExpr) override;
+        void visit(const IfExpr & ifExpr) override;
+        void visit(const Infix & infix) override;
+        void visit(const Invoke & invoke) override;
+        void visit(const Lambda & lambdaExpr) override;
+        void visit(const LambdaParam & param) override;
+        void visit(const ListExpr & listExpr) override;
+        void visit(const LiteralConstant & literalConstant) override;
+        void visit(const LoopExpr & loopExpr) override;
+        void visit(const MemberAccess & memberAccess) override;
+        void visit(const ParenExpr & parenExpr) override;
+        void visit(const PathExpr & pathExpr) override;
+        void visit(const PathExprSeg & seg) override;
+        void visit(const Prefix & prefix) override;
+        void visit(const QuestExpr & questExpr) override;
+        void visit(const ReturnExpr & returnExpr) override;
+        void visit(const SpreadExpr & spreadExpr) override;
+        void visit(const StructExpr & structExpr) override;
+        void visit(const StructExprField & field) override;
+        void visit(const Subscript & subscript) override;
+        void visit(const ThisExpr & thisExpr) override;
+        void visit(const TupleExpr & tupleExpr) override;
+        void visit(const UnitExpr & unitExpr) override;
+        void visit(const WhenExpr & whenExpr) override;
+        void visit(const WhenEntry & entry) override;
+
+        // Types //
+        void visit(const ParenType & parenType) override;
+        void visit(const TupleType & tupleType) override;
+        void visit(const TupleTypeEl & el) override;
+        void visit(const FuncType & funcType) override;
+        void visit(const SliceType & listType) override;
+        void visit(const ArrayType & arrayType) override;
+        void visit(const TypePath & typePath) override;
+        void visit(const TypePathSeg & seg) override;
+        void visit(const UnitType & unitType) override;
+
+        // Type params //
+        void visit(const GenericType & genericType) override;
+        void visit(const Lifetime & lifetime) override;
+        void visit(const ConstParam & constParam) override;
+
+        // Fragments //
+        void visit(const Attribute & attr) override;
+        void visit(const Identifier & id) override;
+        void visit(const NamedElement & el) override;
+        void visit(const SimplePath & path) override;
+        void visit(const SimplePathSeg & seg) override;
+
+    private:
+        using StubVisitor::visit;
+
+    private:
+        common::Logger log{"AstStats"};
+
+        struct KindStats {
+            size_t count{0};
+            size_t bytes{0};
+            size_t maxDepth{0};
+        };
+
+        struct FileStats {
+            std::string name;
+            size_t nodes{0};
+            size_t bytes{0};
+            size_t maxDepth{0};
+            size_t edges{0};
+            size_t parents{0};
+
+            double avgFanOut() const {
+                return parents == 0 ? 0.0 : static_cast<double>(edges) / static_cast<double>(parents);
+            }
+        };
+
+        struct MemStats {
+            size_t count{0};
+            size_t bytes{0};
+        };
+
+        std::map<std::string, KindStats> kinds;
+        std::vector<FileStats> files;
+        MemStats tokens;
+        MemStats nodeMap;
+        MemStats sourceMap;
+
+        // Traversal state //
+        FileStats * currentFile{nullptr};
+        std::vector<size_t> childrenStack;
+
+        template<class T>
+        void enter(const T &, const std::string & kind, size_t heapBytes = 0) {
+            const auto bytes = sizeof(T) + CONTROL_BLOCK_SIZE + heapBytes;
+            if (not childrenStack.empty()) {
+                childrenStack.back()++;
+            }
+            childrenStack.push_back(0);
+            const auto depth = childrenStack.size();
+
+            auto & stats = kinds[kind];
+            stats.count++;
+            stats.bytes += bytes;
+            stats.maxDepth = std::max(stats.maxDepth, depth);
+
+            if (currentFile) {
+                currentFile->nodes++;
+                currentFile->bytes += bytes;
+                currentFile->maxDepth = std::max(currentFile->maxDepth, depth);
+            }
+        }
+
+        void exit();
+
+        // Heap size helpers //
+        /// Approximate size of `std::make_shared` control block: vtable pointer and two reference counters
+        constexpr static size_t CONTROL_BLOCK_SIZE = sizeof(void*) + 2 * sizeof(int);
+
+        template<class T>
+        static size_t vecBytes(const std::vector<T> & vec) {
+            return vec.capacity() * sizeof(T);
+        }
+
+        static size_t strBytes(const std::string & str);
+        static size_t tokenBytes(const parser::Token & token);
+        static size_t tokensBytes(const parser::token_list & tokens);
+        static size_t typeParamsBytes(const opt_type_params & typeParams);
+        static size_t enumEntryBytes(const EnumEntry & enumEntry);
+    };
+}
+
+#endif // JACY_AST_ASTSTATS_H
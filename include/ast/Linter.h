@@ -7,6 +7,7 @@
 #include "suggest/BaseSugg.h"
 #include "data_types/SuggResult.h"
 #include "suggest/SuggInterface.h"
+#include "session/Session.h"
 
 namespace jc::ast {
     using common::Logger;
@@ -25,7 +26,8 @@ namespace jc::ast {
     public:
         Linter();
 
-        dt::SuggResult<dt::none_t> lint(const Party & party);
+        dt::SuggResult<dt::none_t> lint(const sess::sess_ptr & sess, const Party & party);
+        dt::SuggResult<dt::none_t> lintFile(const sess::sess_ptr & sess, const FileModule & fileModule);
 
     private:
         void visit(const ErrorNode & errorNode) override;
@@ -136,11 +138,20 @@ namespace jc::ast {
     private:
         std::vector<LinterContext> ctxStack;
         bool isInside(LinterContext ctx);
-        bool isDeepInside(LinterContext ctx);
+        bool isInsideLoop(node_id nodeId);
         void pushContext(LinterContext ctx);
         void popContext();
 
         common::Logger log{"linter"};
+
+        // Duplicates //
+    private:
+        /// Minimal count of nodes in function body to be reported as duplicate
+        constexpr static uint32_t MIN_DUPLICATE_SIZE = 8;
+
+        sess::sess_ptr sess;
+        std::unordered_map<utils::hash::Hash128, id_ptr> funcBodies;
+        void lintDuplicateBody(const Func & func, node_id bodyId);
     };
 }
 
@@ -8,6 +8,7 @@
 #include "parser/Token.h"
 #include "data_types/Result.h"
 #include "ast/BaseVisitor.h"
+#include "utils/stack.h"
 
 namespace jc::ast {
     struct Node;
@@ -154,11 +155,14 @@ namespace jc::ast {
             if (not inited) {
                 common::Logger::devPanic("Use of uninitialized ParseResult");
             }
-            if (hasErr) {
-                return error->accept(visitor);
-            } else {
-                return value->accept(visitor);
-            }
+            // Visitors recurse through `ParseResult` children, so deep trees continue on new stack segments
+            utils::stack::ensureSufficient([&]() {
+                if (hasErr) {
+                    error->accept(visitor);
+                } else {
+                    value->accept(visitor);
+                }
+            });
         }
 
     protected:
@@ -2,8 +2,15 @@
 #define JACY_AST_NODEMAP_H
 
 #include "ast/Node.h"
+#include "utils/hash.h"
 
 namespace jc::ast {
+    /// Structural hash of node subtree, see `StructHasher`
+    struct StructHash {
+        utils::hash::Hash128 hash;
+        uint32_t size{0};
+    };
+
     class NodeMap {
     public:
         NodeMap() = default;
@@ -19,13 +26,35 @@ namespace jc::ast {
             return node;
         }
 
+        /// Allocate id for definition without AST node (e.g. loaded from module metadata)
+        node_id reserveId() {
+            if (currentNodeId == NONE_NODE_ID) {
+                common::Logger::devPanic("Nodes count exceeded");
+            }
+            return currentNodeId++;
+        }
+
         const Node & getNode(node_id nodeId) const;
         const Span & getNodeSpan(node_id nodeId) const;
         node_ptr getNodePtr(node_id nodeId) const;
+        size_t size() const;
+
+        /// Count of allocated ids including reserved ones, bounds every node id (unlike `size`)
+        size_t idsCount() const {
+            return currentNodeId;
+        }
+
+        /// Drop nodes with ids in `[begin, end)` and their structural hashes, e.g. nodes of re-parsed file.
+        /// Ids are not reused, so dropped ones are never allocated again.
+        void eraseNodes(node_id begin, node_id end);
+
+        void setStructHash(node_id nodeId, const StructHash & hash);
+        const StructHash & getStructHash(node_id nodeId) const;
 
     private:
         node_id currentNodeId{0};
         std::map<node_id, node_ptr> nodes;
+        std::unordered_map<node_id, StructHash> structHashes;
     };
 }
 
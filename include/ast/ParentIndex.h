@@ -0,0 +1,57 @@
+#ifndef JACY_AST_PARENTINDEX_H
+#define JACY_AST_PARENTINDEX_H
+
+#include <vector>
+
+#include "ast/Node.h"
+
+namespace jc::ast {
+    /// ParentIndex
+    /// @brief Side table keyed by node id with parent links and preorder intervals
+    /// Node `A` is a descendant of node `B` if `B.preorder < A.preorder < B.subtreeEnd`, so ancestor queries are O(1).
+    /// Preorder numbers of file start from its first node id, so intervals of different files never intersect
+    ///  and file can be indexed again alone.
+    /// Nearest enclosing function-like (`Func` or `Lambda`) and loop-like (`while`, `for`, `loop`) nodes
+    ///  are precomputed for each node.
+    class ParentIndex {
+    public:
+        ParentIndex() = default;
+
+        struct Entry {
+            node_id parent{NONE_NODE_ID};
+            node_id enclosingFunc{NONE_NODE_ID};
+            node_id enclosingLoop{NONE_NODE_ID};
+            uint32_t preorder{0};
+            uint32_t subtreeEnd{0};
+        };
+
+        void reset(size_t nodesCount);
+
+        /// Make room for new nodes keeping entries of existing ones
+        void grow(size_t nodesCount);
+
+        void setEntry(node_id nodeId, const Entry & entry);
+        void setSubtreeEnd(node_id nodeId, uint32_t subtreeEnd);
+
+        const Entry & getEntry(node_id nodeId) const;
+        opt_node_id getParent(node_id nodeId) const;
+        uint32_t getPreorder(node_id nodeId) const;
+        uint32_t getSubtreeEnd(node_id nodeId) const;
+
+        /// Checks if `nodeId` is a descendant of `ancestorId` (node is not inside itself)
+        bool isInside(node_id nodeId, node_id ancestorId) const;
+
+        /// Nearest `Func` or `Lambda` strictly enclosing the node
+        opt_node_id getEnclosingFunc(node_id nodeId) const;
+
+        /// Nearest `while`, `for` or `loop` strictly enclosing the node
+        opt_node_id getEnclosingLoop(node_id nodeId) const;
+
+    private:
+        std::vector<Entry> entries;
+
+        static opt_node_id optId(node_id nodeId);
+    };
+}
+
+#endif // JACY_AST_PARENTINDEX_H
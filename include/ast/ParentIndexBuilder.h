@@ -0,0 +1,43 @@
+#ifndef JACY_AST_PARENTINDEXBUILDER_H
+#define JACY_AST_PARENTINDEXBUILDER_H
+
+#include "ast/Walker.h"
+#include "session/Session.h"
+
+namespace jc::ast {
+    /// ParentIndexBuilder
+    /// @brief Fills `ParentIndex` of session in one preorder pass over the party
+    /// Files are traversed by `Walker`, node enter and exit give bounds of its preorder interval.
+    /// Preorder of file starts from its first node id, so a re-parsed file is indexed by `buildFile` alone.
+    class ParentIndexBuilder : public StubVisitor {
+    public:
+        ParentIndexBuilder();
+
+        void build(const sess::sess_ptr & sess, const Party & party);
+        void buildFile(const sess::sess_ptr & sess, const FileModule & fileModule);
+
+        void visit(const FileModule & fileModule) override;
+
+    private:
+        using StubVisitor::visit;
+
+    private:
+        struct Frame {
+            node_id nodeId;
+            node_id enclosingFunc;
+            node_id enclosingLoop;
+        };
+
+        sess::sess_ptr sess;
+        Walker walker;
+        std::vector<Frame> frames;
+        uint32_t preorder{0};
+        node_id enclosingFunc{NONE_NODE_ID};
+        node_id enclosingLoop{NONE_NODE_ID};
+
+        void enter(const Node & node);
+        void exit();
+    };
+}
+
+#endif // JACY_AST_PARENTINDEXBUILDER_H
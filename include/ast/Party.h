@@ -34,14 +34,33 @@ namespace jc::ast {
         virtual void accept(DirTreePrinter & visitor) const = 0;
     };
 
+    /// Nodes of file are parsed at once, so their ids are contiguous range `[firstNodeId, endNodeId)`
     struct FileModule : Module {
-        FileModule(const std::string & name, span::file_id_t fileId, file_ptr && file)
-            : Module(Module::Kind::File), name(name), fileId(fileId), file(std::move(file)) {}
+        FileModule(
+            const std::string & name,
+            span::file_id_t fileId,
+            file_ptr && file,
+            node_id firstNodeId,
+            node_id endNodeId
+        ) : Module(Module::Kind::File),
+            name(name),
+            fileId(fileId),
+            file(std::move(file)),
+            firstNodeId(firstNodeId),
+            endNodeId(endNodeId) {}
 
         span::file_id_t getFileId() const {
             return fileId;
         }
 
+        node_id getFirstNodeId() const {
+            return firstNodeId;
+        }
+
+        node_id getEndNodeId() const {
+            return endNodeId;
+        }
+
         const file_ptr & getFile() const {
             return file;
         }
@@ -62,6 +81,8 @@ namespace jc::ast {
         std::string name;
         span::file_id_t fileId;
         file_ptr file;
+        node_id firstNodeId;
+        node_id endNodeId;
     };
 
     struct DirModule : Module {
@@ -76,6 +97,10 @@ namespace jc::ast {
             return modules;
         }
 
+        std::vector<module_ptr> takeModules() {
+            return std::move(modules);
+        }
+
         void accept(BaseVisitor & visitor) const override {
             return visitor.visit(*this);
         }
@@ -101,6 +126,14 @@ namespace jc::ast {
             return rootDir;
         }
 
+        file_module_ptr takeRootFile() {
+            return std::move(rootFile);
+        }
+
+        dir_module_ptr takeRootDir() {
+            return std::move(rootDir);
+        }
+
         void accept(BaseVisitor & visitor) const override {
             visitor.visit(*this);
         }
@@ -122,6 +155,11 @@ namespace jc::ast {
             return rootModule;
         }
 
+        /// Take module tree out of party, e.g. to reuse unchanged files in rebuilt party
+        root_module_ptr takeRootModule() {
+            return std::move(rootModule);
+        }
+
     private:
         root_module_ptr rootModule;
     };
@@ -0,0 +1,133 @@
+#ifndef JACY_AST_STRUCTHASHER_H
+#define JACY_AST_STRUCTHASHER_H
+
+#include "ast/Walker.h"
+#include "session/Session.h"
+
+namespace jc::ast {
+    /// StructHasher
+    /// @brief Computes 128-bit structural hash of each node subtree bottom-up and stores it in `NodeMap`
+    /// Tree is traversed by `Walker`, visitor methods only add node kind and node own data (tokens, names, flags).
+    /// Hash depends only on node kinds, tokens and identifiers, spans and node ids are ignored,
+    ///  so equal code gives equal hashes in different places and between compilations.
+    class StructHasher : public StubVisitor {
+    public:
+        StructHasher();
+
+        void hash(const sess::sess_ptr & sess, const Party & party);
+        void hashFile(const sess::sess_ptr & sess, const FileModule & fileModule);
+
+        void visit(const FileModule & fileModule) override;
+        void visit(const ErrorNode & errorNode) override;
+        void visit(const File & file) override;
+
+        // Items //
+        void visit(const Enum & enumDecl) override;
+        void visit(const EnumEntry & enumEntry) override;
+        void visit(const Func & func) override;
+        void visit(const FuncParam & funcParam) override;
+        void visit(const Impl & impl) override;
+        void visit(const Mod & mod) override;
+        void visit(const Struct & _struct) override;
+        void visit(const StructField & field) override;
+        void visit(const Trait & trait) override;
+        void visit(const TypeAlias & typeAlias) override;
+        void visit(const UseDecl & useDecl) override;
+        void visit(const UseTreeRaw & useTree) override;
+        void visit(const UseTreeSpecific & useTree) override;
+        void visit(const UseTreeRebind & useTree) override;
+        void visit(const UseTreeAll & useTree) override;
+
+        // Statements //
+        void visit(const ExprStmt & exprStmt) override;
+        void visit(const ForStmt & forStmt) override;
+        void visit(const ItemStmt & itemStmt) override;
+        void visit(const VarStmt & varStmt) override;
+        void visit(const WhileStmt & whileStmt) override;
+
+        // Expressions //
+        void visit(const Assignment & assign) override;
+        void visit(const Block & block) override;
+        void visit(const BorrowExpr & borrowExpr) override;
+        void visit(const BreakExpr & breakExpr) override;
+        void visit(const ContinueExpr & continueExpr) override;
+        void visit(const DerefExpr & derefExpr) override;
+        void visit(const IfExpr & ifExpr) override;
+        void visit(const Infix & infix) override;
+        void visit(const Invoke & invoke) override;
+        void visit(const Lambda & lambdaExpr) override;
+        void visit(const LambdaParam & param) override;
+        void visit(const ListExpr & listExpr) override;
+        void visit(const LiteralConstant & literalConstant) override;
+        void visit(const LoopExpr & loopExpr) override;
+        void visit(const MemberAccess & memberAccess) override;
+        void visit(const ParenExpr & parenExpr) override;
+        void visit(const PathExpr & pathExpr) override;
+        void visit(const PathExprSeg & seg) override;
+        void visit(const Prefix & prefix) override;
+        void visit(const QuestExpr & questExpr) override;
+        void visit(const ReturnExpr & returnExpr) override;
+        void visit(const SpreadExpr & spreadExpr) override;
+        void visit(const StructExpr & structExpr) override;
+        void visit(const StructExprField & field) override;
+        void visit(const Subscript & subscript) override;
+        void visit(const ThisExpr & thisExpr) override;
+        void visit(const TupleExpr & tupleExpr) override;
+        void visit(const UnitExpr & unitExpr) override;
+        void visit(const WhenExpr & whenExpr) override;
+        void visit(const WhenEntry & entry) override;
+
+        // Types //
+        void visit(const ParenType & parenType) override;
+        void visit(const TupleType & tupleType) override;
+        void visit(const TupleTypeEl & el) override;
+        void visit(const FuncType & funcType) override;
+        void visit(const SliceType & listType) override;
+        void visit(const ArrayType & arrayType) override;
+        void visit(const TypePath & typePath) override;
+        void visit(const TypePathSeg & seg) override;
+        void visit(const UnitType & unitType) override;
+
+        // Type params //
+        void visit(const GenericType & genericType) override;
+        void visit(const Lifetime & lifetime) override;
+        void visit(const ConstParam & constParam) override;
+
+        // Fragments //
+        void visit(const Attribute & attr) override;
+        void visit(const Identifier & id) override;
+        void visit(const NamedElement & el) override;
+        void visit(const SimplePath & path) override;
+        void visit(const SimplePathSeg & seg) override;
+
+    private:
+        using StubVisitor::visit;
+
+    private:
+        struct Frame {
+            utils::hash::Hasher128 hasher;
+            uint32_t children{0};
+            uint32_t size{1};
+        };
+
+        sess::sess_ptr sess;
+        Walker walker;
+        std::vector<Frame> frames;
+
+        void enter(const Node & node);
+        void exit(const Node & node);
+
+        void add(const std::string & str);
+
+        void add(const char * str) {
+            add(std::string(str));
+        }
+
+        template<class T>
+        void add(T value) {
+            frames.back().hasher.add(static_cast<uint64_t>(value));
+        }
+    };
+}
+
+#endif // JACY_AST_STRUCTHASHER_H
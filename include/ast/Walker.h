@@ -0,0 +1,174 @@
+#ifndef JACY_AST_WALKER_H
+#define JACY_AST_WALKER_H
+
+#include <functional>
+#include <type_traits>
+
+#include "ast/StubVisitor.h"
+
+namespace jc::ast {
+    /// Role of node in control flow scoping, e.g. `break` refers to the nearest loop-like node
+    enum class NodeRole : uint8_t {
+        Other,
+        FuncLike, // `Func` or `Lambda`
+        LoopLike, // `while`, `for` or `loop`
+    };
+
+    /// ChildrenCollector
+    /// @brief Collects direct children of node in visiting order without descending into them
+    /// The first `accept` expands given node using `StubVisitor`, nested `accept` calls only record child.
+    class ChildrenCollector : public StubVisitor {
+    public:
+        ChildrenCollector();
+
+        const std::vector<const Node*> & collect(const Node & node);
+
+        /// Role of node last given to `collect`
+        NodeRole getRole() const {
+            return role;
+        }
+
+        void visit(const ErrorNode & errorNode) override;
+        void visit(const File & file) override;
+
+        // Items //
+        void visit(const Enum & enumDecl) override;
+        void visit(const EnumEntry & enumEntry) override;
+        void visit(const Func & func) override;
+        void visit(const FuncParam & funcParam) override;
+        void visit(const Impl & impl) override;
+        void visit(const Mod & mod) override;
+        void visit(const Struct & _struct) override;
+        void visit(const StructField & field) override;
+        void visit(const Trait & trait) override;
+        void visit(const TypeAlias & typeAlias) override;
+        void visit(const UseDecl & useDecl) override;
+        void visit(const UseTreeRaw & useTree) override;
+        void visit(const UseTreeSpecific & useTree) override;
+        void visit(const UseTreeRebind & useTree) override;
+        void visit(const UseTreeAll & useTree) override;
+
+        // Statements //
+        void visit(const ExprStmt & exprStmt) override;
+        void visit(const ForStmt & forStmt) override;
+        void visit(const ItemStmt & itemStmt) override;
+        void visit(const VarStmt & varStmt) override;
+        void visit(const WhileStmt & whileStmt) override;
+
+        // Expressions //
+        void visit(const Assignment & assign) override;
+        void visit(const Block & block) override;
+        void visit(const BorrowExpr & borrowExpr) override;
+        void visit(const BreakExpr & breakExpr) override;
+        void visit(const ContinueExpr & continueExpr) override;
+        void visit(const DerefExpr & derefExpr) override;
+        void visit(const IfExpr & ifExpr) override;
+        void visit(const Infix & infix) override;
+        void visit(const Invoke & invoke) override;
+        void visit(const Lambda & lambdaExpr) override;
+        void visit(const LambdaParam & param) override;
+        void visit(const ListExpr & listExpr) override;
+        void visit(const LiteralConstant & literalConstant) override;
+        void visit(const LoopExpr & loopExpr) override;
+        void visit(const MemberAccess & memberAccess) override;
+        void visit(const ParenExpr & parenExpr) override;
+        void visit(const PathExpr & pathExpr) override;
+        void visit(const PathExprSeg & seg) override;
+        void visit(const Prefix & prefix) override;
+        void visit(const QuestExpr & questExpr) override;
+        void visit(const ReturnExpr & returnExpr) override;
+        void visit(const SpreadExpr & spreadExpr) override;
+        void visit(const StructExpr & structExpr) override;
+        void visit(const StructExprField & field) override;
+        void visit(const Subscript & subscript) override;
+        void visit(const ThisExpr & thisExpr) override;
+        void visit(const TupleExpr & tupleExpr) override;
+        void visit(const UnitExpr & unitExpr) override;
+        void visit(const WhenExpr & whenExpr) override;
+        void visit(const WhenEntry & entry) override;
+
+        // Types //
+        void visit(const ParenType & parenType) override;
+        void visit(const TupleType & tupleType) override;
+        void visit(const TupleTypeEl & el) override;
+        void visit(const FuncType & funcType) override;
+        void visit(const SliceType & listType) override;
+        void visit(const ArrayType & arrayType) override;
+        void visit(const TypePath & typePath) override;
+        void visit(const TypePathSeg & seg) override;
+        void visit(const UnitType & unitType) override;
+
+        // Type params //
+        void visit(const GenericType & genericType) override;
+        void visit(const Lifetime & lifetime) override;
+        void visit(const ConstParam & constParam) override;
+
+        // Fragments //
+        void visit(const Attribute & attr) override;
+        void visit(const Identifier & id) override;
+        void visit(const NamedElement & el) override;
+        void visit(const SimplePath & path) override;
+        void visit(const SimplePathSeg & seg) override;
+
+    private:
+        using StubVisitor::visit;
+
+    private:
+        bool expanding{false};
+        NodeRole role{NodeRole::Other};
+        std::vector<const Node*> children;
+
+        template<class T>
+        constexpr static NodeRole roleOf() {
+            if constexpr (std::is_same_v<T, Func> or std::is_same_v<T, Lambda>) {
+                return NodeRole::FuncLike;
+            } else if constexpr (
+                std::is_same_v<T, ForStmt> or std::is_same_v<T, WhileStmt> or std::is_same_v<T, LoopExpr>
+            ) {
+                return NodeRole::LoopLike;
+            } else {
+                return NodeRole::Other;
+            }
+        }
+
+        template<class T>
+        void onNode(const T & node) {
+            if (expanding) {
+                expanding = false;
+                role = roleOf<T>();
+                StubVisitor::visit(node);
+            } else {
+                children.push_back(&node);
+            }
+        }
+    };
+
+    /// Walker
+    /// @brief Non-recursive pre- and post-order traversal of node subtree using explicit stack,
+    ///  thus deeply nested trees cost memory linear to their depth but not the native stack.
+    class Walker {
+    public:
+        using walk_cb = std::function<void(const Node & node, size_t depth)>;
+
+        Walker() = default;
+
+        void walk(const Node & root, const walk_cb & enter, const walk_cb & exit = nullptr);
+
+        /// Role of node given to the running `enter` callback
+        NodeRole getRole() const {
+            return collector.getRole();
+        }
+
+    private:
+        struct Frame {
+            const Node * node;
+            size_t depth;
+            bool expanded;
+        };
+
+        ChildrenCollector collector;
+        std::vector<Frame> stack;
+    };
+}
+
+#endif // JACY_AST_WALKER_H
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "ast/Node.h"
+#include "span/Symbol.h"
 
 namespace jc::ast {
     struct Identifier;
@@ -11,13 +12,13 @@ namespace jc::ast {
     using opt_id_ptr = dt::Option<id_ptr>;
 
     struct Identifier : Node {
-        explicit Identifier(parser::Token token, const Span & span)
-            : Node(span), token(token) {}
+        explicit Identifier(span::Symbol sym, const Span & span)
+            : Node(span), sym(sym) {}
 
-        parser::Token token;
+        span::Symbol sym;
 
-        std::string getValue() const {
-            return token.val;
+        const std::string & getValue() const {
+            return sym.toString();
         }
 
         void accept(BaseVisitor & visitor) const override {
@@ -37,6 +37,8 @@ namespace jc::common {
             Suggestions,
             Source,
             Names,
+            AstStats,
+            AstStatsJson,
 
             All,
         };
@@ -53,12 +55,29 @@ namespace jc::common {
             EachStage,
         };
 
+        enum class IoBackend {
+            Auto,
+            Uring,
+            Threads,
+        };
+
         // Checkers //
         bool checkMode(Mode mode) const;
         bool checkPrint(PrintKind printKind) const;
         bool checkBenchmark(Benchmark benchmark) const;
         bool checkDev() const;
+        bool checkCache() const;
+        bool checkWatch() const;
+        bool checkInMemory() const;
+        size_t getCacheSize() const;
         const std::string & getRootFile() const;
+        uint32_t getMaxNesting() const;
+        uint32_t getJobs() const;
+        const std::vector<std::string> & getExterns() const;
+        const std::vector<std::string> & getIncludes() const;
+        const std::vector<std::string> & getExcludes() const;
+        const std::string & getEmitMeta() const;
+        IoBackend getIoBackend() const;
 
     private:
         std::string rootFile;
@@ -68,9 +87,20 @@ namespace jc::common {
         std::set<PrintKind> print;
         Benchmark benchmark{Benchmark::Final};
         CompileDepth compileDepth{CompileDepth::Full};
+        uint32_t maxNesting{256};
+        uint32_t jobs{0}; // `0` means count of hardware threads
+        std::vector<std::string> externs; // Module metadata files of precompiled parties
+        std::vector<std::string> includes; // Globs of source files to compile, all if empty
+        std::vector<std::string> excludes; // Globs of entries skipped by project discovery
+        std::string emitMeta; // Empty if module metadata is not emitted
+        uint32_t cacheSizeMb{64};
+        IoBackend ioBackend{IoBackend::Auto};
 
         // Bool args //
         bool dev{false};
+        bool cache{false};
+        bool watch{false};
+        bool inMemory{false}; // Preload sources into memory, so disk does not affect benchmarks
     };
 }
 
@@ -119,8 +119,9 @@ namespace jc::common {
         }
 
         // DEBUG //
+        /// Always throws, so functions ending with it need no return value
         template<class Arg, class ...Args>
-        static void devPanic(Arg && first, Args && ...other);
+        [[noreturn]] static void devPanic(Arg && first, Args && ...other);
 
         static void notImplemented(const std::string & what) {
             Logger::devPanic("Not implemented error: `" + what + "`");
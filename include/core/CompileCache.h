@@ -0,0 +1,65 @@
+#ifndef JACY_CORE_COMPILECACHE_H
+#define JACY_CORE_COMPILECACHE_H
+
+#include <filesystem>
+
+#include "parser/Token.h"
+#include "utils/hash.h"
+
+namespace jc::core {
+    namespace std_fs = std::filesystem;
+
+    /// CompileCache
+    /// @brief On-disk cache of stage outputs in `.jacy-cache` directory
+    /// Entry is keyed by hash of file contents and compiler build id, so stale entries are never hit,
+    ///  they are just evicted as least recently used when cache exceeds size limit.
+    /// Entries are written to temporary file and renamed, so concurrent compilers never see partial entry.
+    class CompileCache {
+        constexpr static uint32_t MAGIC = 0x4B544A2E; // ".JTK"
+        constexpr static uint32_t VERSION = 1;
+        constexpr static auto TOKENS_KIND = "tokens";
+
+    public:
+        struct Stats {
+            size_t hits{0};
+            size_t misses{0};
+            /// Size of sources stages of which were skipped
+            size_t bytesSaved{0};
+            size_t stored{0};
+            size_t evicted{0};
+        };
+
+        CompileCache(const std_fs::path & dir, size_t maxBytes);
+
+        /// Key of entry for file with `contentHash` (see `utils::hash::contentHash`)
+        utils::hash::Hash128 keyFor(const utils::hash::Hash128 & contentHash) const;
+
+        /// Load token stream of file, spans are bound to `fileId`
+        dt::Option<parser::token_list> loadTokens(
+            const utils::hash::Hash128 & key,
+            span::file_id_t fileId,
+            size_t sourceSize
+        );
+
+        void storeTokens(const utils::hash::Hash128 & key, const parser::token_list & tokens);
+
+        /// Remove least recently used entries until cache fits the size limit
+        void evict();
+
+        const Stats & getStats() const {
+            return stats;
+        }
+
+    private:
+        common::Logger log{"CompileCache"};
+        std_fs::path dir;
+        size_t maxBytes;
+        utils::hash::Hash128 buildId;
+        Stats stats;
+
+        std_fs::path entryPath(const utils::hash::Hash128 & key, const std::string & kind) const;
+        static utils::hash::Hash128 computeBuildId();
+    };
+}
+
+#endif // JACY_CORE_COMPILECACHE_H
@@ -10,14 +10,24 @@
 #include "parser/Lexer.h"
 #include "parser/Parser.h"
 #include "ast/AstPrinter.h"
+#include "ast/AstStats.h"
+#include "ast/StructHasher.h"
+#include "ast/ParentIndexBuilder.h"
 #include "suggest/SuggDumper.h"
 #include "suggest/Suggester.h"
 #include "ast/Linter.h"
 #include "resolve/NameResolver.h"
 #include "resolve/ModuleTreeBuilder.h"
+#include "resolve/ImportResolver.h"
+#include "resolve/ModuleMeta.h"
 #include "common/Config.h"
+#include "core/CompileCache.h"
 #include "ast/Party.h"
 #include "fs/fs.h"
+#include "fs/Watcher.h"
+#include "fs/TreeManifest.h"
+#include "fs/PathFilter.h"
+#include "core/SourcePipeline.h"
 #include "session/Session.h"
 
 namespace jc::core {
@@ -28,41 +38,107 @@ namespace jc::core {
     class Interface {
     public:
         Interface();
+
+        /// Party sources are read from `vfs`, e.g. in-memory buffers
+        explicit Interface(fs::vfs_ptr vfs);
         virtual ~Interface() = default;
 
         void compile();
 
+        /// Watch party directory and recompile changed files until process is stopped
+        void watch();
+
     private:
         void init();
+
+        /// Include and exclude globs of CLI and patterns of ignore file in project directory
+        void initPathFilter(const fs::std_fs::path & projectDir);
         Config & config;
+        fs::vfs_ptr vfs;
 
         // Parsing //
     private:
-        parser::Lexer lexer;
+        std::unique_ptr<CompileCache> cache;
+
+        /// Directory tree of previous run, kept with cache of disk party
+        std::unique_ptr<fs::TreeManifest> manifest;
+        fs::std_fs::path manifestPath;
+
+        fs::PathFilter pathFilter;
+
         parser::Parser parser;
         ast::DirTreePrinter dirTreePrinter;
         ast::AstPrinter astPrinter;
+        ast::AstStats astStats;
+        ast::StructHasher structHasher;
+        ast::ParentIndexBuilder parentIndexBuilder;
         ast::Linter linter;
         dt::Option<ast::party_ptr> party;
 
         void parse();
+        void hashAst();
+        void indexAst();
         void lintAst();
         ast::dir_module_ptr parseDir(const fs::entry_ptr & dir, const std::string & ignore = "");
         ast::file_module_ptr parseFile(const fs::entry_ptr & file);
 
+        // Source pipeline //
+    private:
+        constexpr static size_t SOURCE_QUEUE_CAPACITY = 16;
+
+        std::unique_ptr<SourcePipeline> pipeline;
+        dt::Option<SourcePipeline::Stats> pipelineStats;
+
+        static bool isModuleEntry(const fs::entry_ptr & entry, const std::string & ignore);
+        void collectSources(const fs::entry_ptr & dir, const std::string & ignore, std::vector<fs::path> & paths);
+        void startPipeline(const fs::entry_ptr & rootFile, const fs::entry_ptr & dir, const std::string & ignore);
+        void stopPipeline();
+        LexedFile takeLexedFile(span::file_id_t fileId);
+
+        // Watch mode //
+    private:
+        constexpr static std::chrono::milliseconds WATCH_DEBOUNCE{50};
+
+        size_t watchIteration{0};
+
+        /// Files of previous party reused by `parse` instead of parsing them again
+        std::unordered_map<span::file_id_t, ast::file_module_ptr> reusedFiles;
+
+        /// Files parsed by last `parse`
+        std::vector<span::file_id_t> parsedFiles;
+
+        /// Parsed files not yet passed through all stages, e.g. because iteration stopped on error
+        std::unordered_set<span::file_id_t> dirtyFiles;
+
+        /// Files whose last parse produced suggestions, they are never reused, so suggestions are reported again
+        std::unordered_set<span::file_id_t> erroneousFiles;
+
+        void recompile(const std::vector<fs::path> & changedPaths);
+        void releaseParty(const std::unordered_set<span::file_id_t> & changedFiles);
+        void releaseModules(ast::module_list && modules, const std::unordered_set<span::file_id_t> & changedFiles);
+        void reuseFile(ast::file_module_ptr && file, const std::unordered_set<span::file_id_t> & changedFiles);
+
+        /// Release nodes of file which is not a part of party anymore, AST of it is freed with the module
+        void dropFile(const ast::FileModule & file);
+        void collectFileModules(const ast::Module & module, std::vector<const ast::FileModule*> & files) const;
+
         // Debug //
         void printDirTree();
         void printSource(span::file_id_t fileId);
         void printTokens(span::file_id_t fileId, const parser::token_list & tokens);
         void printAst(ast::AstPrinterMode mode);
+        void printAstStats();
 
         // Name resolution //
     private:
         resolve::ModuleTreeBuilder moduleTreeBuilder;
+        resolve::ImportResolver importResolver;
         resolve::ModulePrinter modulePrinter;
         resolve::NameResolver nameResolver;
 
         void resolveNames();
+        void loadExterns();
+        void emitModuleMeta();
 
     private:
         common::Logger log{"Interface"};
@@ -83,6 +159,8 @@ namespace jc::core {
         enum class BenchmarkKind {
             Lexing,
             Parsing,
+            ModuleTreeBuilding,
+            NameResolution,
         };
         bench_t finalBenchStart;
         std::map<std::string, double> benchmarks;
@@ -92,6 +170,8 @@ namespace jc::core {
         void printFinalBench();
         void beginBench();
         void endBench(const std::string & name, BenchmarkKind kind);
+        void addBench(const std::string & name, BenchmarkKind kind, double ms);
+        static void printQueueStats(const std::string & name, const utils::thread::QueueStats & stats) noexcept;
         void printBenchmarks() noexcept;
     };
 }
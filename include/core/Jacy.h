@@ -28,7 +28,7 @@ namespace jc::core {
     private:
         common::Logger log{"jacy"};
         cli::CLI cli;
-        Interface interface;
+        std::unique_ptr<Interface> interface;
     };
 }
 
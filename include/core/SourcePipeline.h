@@ -0,0 +1,93 @@
+#ifndef JACY_CORE_SOURCEPIPELINE_H
+#define JACY_CORE_SOURCEPIPELINE_H
+
+#include <thread>
+#include <exception>
+
+#include "core/CompileCache.h"
+#include "fs/SourceLoader.h"
+#include "parser/Lexer.h"
+
+namespace jc::core {
+    /// Source file after reading and lexing stages
+    struct LexedFile {
+        span::file_id_t fileId{0};
+        fs::LoadedFile loaded;
+        parser::token_list tokens;
+        bool cached{false};
+        double lexingMs{0};
+
+        /// Hash of contents, computed by loader or known from previous run
+        utils::hash::Hash128 contentHash;
+
+        /// Set if file cannot be read or lexer failed, rethrown by parsing stage
+        std::exception_ptr error;
+    };
+
+    /// SourcePipeline
+    /// @brief Staged frontend of party sources: reading → lexing → parsing
+    /// Reading is done by `fs::SourceLoader`, lexing runs on pipeline thread and parsing on the caller thread,
+    ///  so while file N is parsed file N+1 is lexed and next files are read.
+    /// Stages are connected by bounded queues, files go through all stages in order they were given.
+    /// Pipeline thread never touches session, loaded contents are handed to `SourceMap` by the caller.
+    /// File which content hash is known (metadata unchanged since it was hashed) and which tokens are cached
+    ///  is not given to loader, it is only mapped, so its contents are never read.
+    class SourcePipeline {
+    public:
+        struct Stats {
+            fs::SourceLoader::Backend backend{fs::SourceLoader::Backend::Threads};
+            utils::thread::QueueStats readQueue;
+            utils::thread::QueueStats lexQueue;
+            double lexingMs{0};
+            size_t readsSkipped{0};
+            fs::SourceLoader::HashingStats hashing;
+        };
+
+        /// `fileIds` are ids of `paths` in `SourceMap`, `cache` is used only by the pipeline thread.
+        /// `knownHashes` are content hashes of `paths` from previous run (empty if none known), used only with `cache`.
+        SourcePipeline(
+            fs::vfs_ptr vfs,
+            std::vector<std_fs::path> paths,
+            std::vector<span::file_id_t> fileIds,
+            std::vector<dt::Option<utils::hash::Hash128>> knownHashes,
+            size_t workers,
+            bool allowUring,
+            size_t queueCapacity,
+            CompileCache * cache
+        );
+        ~SourcePipeline();
+
+        SourcePipeline(const SourcePipeline&) = delete;
+        SourcePipeline & operator=(const SourcePipeline&) = delete;
+
+        /// Wait for next lexed file, files come in order they were given
+        LexedFile next();
+
+        /// Stop pipeline thread, files which are not taken yet are dropped
+        void stop();
+
+        Stats getStats();
+
+    private:
+        fs::vfs_ptr vfs;
+        std::vector<std_fs::path> paths;
+        std::vector<span::file_id_t> fileIds;
+        std::vector<dt::Option<utils::hash::Hash128>> knownHashes;
+        CompileCache * cache;
+        fs::SourceLoader loader;
+        utils::thread::BoundedQueue<LexedFile> lexed;
+        parser::Lexer lexer;
+        double lexingMs{0};
+        size_t readsSkipped{0};
+        std::thread thread;
+
+        bool isKnown(size_t index) const;
+
+        /// Paths of files which contents must be loaded
+        std::vector<std_fs::path> pathsToLoad() const;
+
+        void lexAll();
+    };
+}
+
+#endif // JACY_CORE_SOURCEPIPELINE_H
@@ -0,0 +1,71 @@
+#ifndef JACY_DATA_TYPES_BLOOMFILTER_H
+#define JACY_DATA_TYPES_BLOOMFILTER_H
+
+#include <vector>
+#include <cstdint>
+
+namespace jc::dt {
+    /// BloomFilter
+    /// @brief Compact negative-lookup filter over 64-bit keys (e.g. symbol ids)
+    /// `mayContain` never gives false negatives, so `false` means the key is definitely absent.
+    /// Filter is built once for a known set of keys with ~10 bits per key and two probes,
+    ///  it is not updated on insertion into the filtered map, call `reset` and re-insert keys instead.
+    class BloomFilter {
+        constexpr static size_t BITS_PER_KEY = 10;
+        constexpr static size_t MIN_BITS = 64;
+
+    public:
+        BloomFilter() = default;
+
+        /// Clear filter and size it for `keysCount` keys
+        void reset(size_t keysCount) {
+            size_t bits = MIN_BITS;
+            while (bits < keysCount * BITS_PER_KEY) {
+                bits <<= 1;
+            }
+            words.assign(bits / 64, 0);
+            built = true;
+        }
+
+        void insert(uint64_t key) {
+            const auto h = mix(key);
+            setBit(h);
+            setBit(h >> 32);
+        }
+
+        /// Filter that was never built accepts everything
+        bool mayContain(uint64_t key) const {
+            if (not built) {
+                return true;
+            }
+            const auto h = mix(key);
+            return testBit(h) and testBit(h >> 32);
+        }
+
+    private:
+        std::vector<uint64_t> words;
+        bool built{false};
+
+        static uint64_t mix(uint64_t key) {
+            // Keys are often small dense integers, so they are spread by multiplication and xor-shift
+            key *= 0x9E3779B97F4A7C15ULL;
+            return key ^ (key >> 29);
+        }
+
+        size_t bitIndex(uint64_t h) const {
+            return static_cast<size_t>(h) & (words.size() * 64 - 1);
+        }
+
+        void setBit(uint64_t h) {
+            const auto index = bitIndex(h);
+            words[index >> 6] |= 1ULL << (index & 63);
+        }
+
+        bool testBit(uint64_t h) const {
+            const auto index = bitIndex(h);
+            return words[index >> 6] & (1ULL << (index & 63));
+        }
+    };
+}
+
+#endif // JACY_DATA_TYPES_BLOOMFILTER_H
@@ -0,0 +1,218 @@
+#ifndef JACY_DATA_TYPES_FLATMAP_H
+#define JACY_DATA_TYPES_FLATMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+
+#include "common/Logger.h"
+
+namespace jc::dt {
+    /// FlatMap
+    /// @brief Open-addressing hash map with linear probing, keys and values are stored inline in one array
+    /// Intended for small trivially copyable keys (e.g. `span::Symbol`), `K` and `V` must be default constructible.
+    /// Erasure uses backward shift, so there are no tombstones and probe sequences stay short.
+    /// Iteration order is unspecified, sort entries if order is observable.
+    template<class K, class V, class Hash = std::hash<K>>
+    class FlatMap {
+        constexpr static size_t MIN_CAPACITY = 8;
+
+        struct Slot {
+            K key{};
+            V value{};
+            bool occupied{false};
+        };
+
+    public:
+        FlatMap() = default;
+
+        size_t size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        size_t capacity() const {
+            return slots.size();
+        }
+
+        void clear() {
+            slots.clear();
+            count = 0;
+        }
+
+        void reserve(size_t n) {
+            // Keep load factor not greater than 3/4
+            size_t cap = MIN_CAPACITY;
+            while (cap * 3 < n * 4) {
+                cap <<= 1;
+            }
+            if (cap > slots.size()) {
+                rehash(cap);
+            }
+        }
+
+        bool has(const K & key) const {
+            return find(key) != nullptr;
+        }
+
+        V * find(const K & key) {
+            return const_cast<V*>(static_cast<const FlatMap*>(this)->find(key));
+        }
+
+        const V * find(const K & key) const {
+            if (slots.empty()) {
+                return nullptr;
+            }
+            for (size_t i = indexFor(key);; i = next(i)) {
+                const auto & slot = slots[i];
+                if (not slot.occupied) {
+                    return nullptr;
+                }
+                if (slot.key == key) {
+                    return &slot.value;
+                }
+            }
+        }
+
+        /// Insert value if key is not present.
+        /// Returns pointer to the value stored for the key and `true` if insertion took place.
+        /// Table is rehashed only when key is new, so emplacing existing key keeps pointers and iteration valid.
+        std::pair<V*, bool> emplace(const K & key, const V & value) {
+            auto * existing = find(key);
+            if (existing) {
+                return {existing, false};
+            }
+            growIfNeeded();
+            for (size_t i = indexFor(key);; i = next(i)) {
+                auto & slot = slots[i];
+                if (not slot.occupied) {
+                    slot.key = key;
+                    slot.value = value;
+                    slot.occupied = true;
+                    count++;
+                    return {&slot.value, true};
+                }
+            }
+        }
+
+        V & operator[](const K & key) {
+            return *emplace(key, V{}).first;
+        }
+
+        V & at(const K & key) {
+            return const_cast<V&>(static_cast<const FlatMap*>(this)->at(key));
+        }
+
+        const V & at(const K & key) const {
+            const auto * value = find(key);
+            if (not value) {
+                common::Logger::devPanic("Called `FlatMap::at` with non-existent key");
+            }
+            return *value;
+        }
+
+        bool erase(const K & key) {
+            if (slots.empty()) {
+                return false;
+            }
+
+            size_t hole = indexFor(key);
+            for (;; hole = next(hole)) {
+                if (not slots[hole].occupied) {
+                    return false;
+                }
+                if (slots[hole].key == key) {
+                    break;
+                }
+            }
+
+            // Backward shift: move following entries of the probe chain into the hole
+            //  if their home slot is not between the hole and their current position
+            for (size_t i = next(hole); slots[i].occupied; i = next(i)) {
+                const auto home = indexFor(slots[i].key);
+                const auto distToHole = (hole - home) & mask();
+                const auto distToCur = (i - home) & mask();
+                if (distToHole < distToCur) {
+                    slots[hole] = std::move(slots[i]);
+                    hole = i;
+                }
+            }
+
+            slots[hole] = Slot{};
+            count--;
+            return true;
+        }
+
+        template<class F>
+        void forEach(F && func) const {
+            for (const auto & slot : slots) {
+                if (slot.occupied) {
+                    func(slot.key, slot.value);
+                }
+            }
+        }
+
+        /// Entries sorted by key with `less`, use where order is observable (e.g. printing).
+        /// Note: `span::Symbol` keys compare by interning order, pass name comparator if order must be stable
+        template<class Less = std::less<K>>
+        std::vector<std::pair<K, V>> sorted(Less less = Less{}) const {
+            std::vector<std::pair<K, V>> entries;
+            entries.reserve(count);
+            forEach([&](const K & key, const V & value) {
+                entries.emplace_back(key, value);
+            });
+            std::sort(entries.begin(), entries.end(), [&](const auto & lhs, const auto & rhs) {
+                return less(lhs.first, rhs.first);
+            });
+            return entries;
+        }
+
+    private:
+        std::vector<Slot> slots;
+        size_t count{0};
+
+        size_t mask() const {
+            return slots.size() - 1;
+        }
+
+        size_t next(size_t index) const {
+            return (index + 1) & mask();
+        }
+
+        size_t indexFor(const K & key) const {
+            // Fibonacci hashing, `std::hash` of integers is identity, so the high bits are taken after mixing
+            const uint64_t mixed = static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<size_t>(mixed >> 32) & mask();
+        }
+
+        void growIfNeeded() {
+            if (slots.empty()) {
+                rehash(MIN_CAPACITY);
+            } else if ((count + 1) * 4 > slots.size() * 3) {
+                rehash(slots.size() * 2);
+            }
+        }
+
+        void rehash(size_t newCapacity) {
+            auto old = std::move(slots);
+            slots = std::vector<Slot>(newCapacity);
+            for (auto & slot : old) {
+                if (not slot.occupied) {
+                    continue;
+                }
+                for (size_t i = indexFor(slot.key);; i = next(i)) {
+                    if (not slots[i].occupied) {
+                        slots[i] = std::move(slot);
+                        break;
+                    }
+                }
+            }
+        }
+    };
+}
+
+#endif // JACY_DATA_TYPES_FLATMAP_H
@@ -5,8 +5,6 @@
 #include <utility>
 #include <vector>
 #include <variant>
-#include <fstream>
-#include <sstream>
 #include <memory>
 
 #include "data_types/Option.h"
@@ -27,8 +25,9 @@ namespace jc::fs {
         Entry(const std_fs::path & path, entry_list && files)
             : kind(Kind::Dir), path(path), content(std::move(files)) {}
 
-        Entry(const std_fs::path & path, std::string && content)
-            : kind(Kind::File), path(path), content(std::move(content)) {}
+        /// File entry which contents are not read, they are mapped by `SourceMap`
+        explicit Entry(const std_fs::path & path)
+            : kind(Kind::File), path(path), content(std::string{}) {}
 
         bool isDir() const {
             return kind == Kind::Dir;
@@ -45,13 +44,6 @@ namespace jc::fs {
             return std::get<entry_list>(content);
         }
 
-        std::string && extractContent() {
-            if (isDir()) {
-                common::Logger::devPanic("Called `fs::Entry::extractContent` on non-file entry");
-            }
-            return std::get<std::string>(std::move(content));
-        }
-
     private:
         Kind kind;
         std_fs::path path;
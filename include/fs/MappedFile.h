@@ -0,0 +1,57 @@
+#ifndef JACY_FS_MAPPEDFILE_H
+#define JACY_FS_MAPPEDFILE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+namespace jc::fs {
+    /// MappedFile
+    /// @brief Read-only view of whole file contents
+    /// On POSIX systems file is memory-mapped, so pages are loaded lazily and shared with page cache,
+    ///  on other systems file is read into owned buffer. Data stays valid while `MappedFile` lives.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile & operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile && other) noexcept;
+        MappedFile & operator=(MappedFile && other) noexcept;
+
+        /// Returns `false` if file cannot be opened or read
+        bool open(const std::filesystem::path & path);
+
+        /// Map `size` bytes of already opened descriptor, descriptor is not closed and may be closed right after
+        bool map(int fd, size_t size);
+        void close();
+
+        const uint8_t * data() const {
+            return bytes;
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+        bool isOpen() const {
+            return opened;
+        }
+
+        /// Hint OS to read whole file ahead, so parsing does not fault on each page
+        void prefetch() const;
+
+    private:
+        const uint8_t * bytes{nullptr};
+        size_t length{0};
+        bool opened{false};
+        bool mapped{false};
+        std::vector<uint8_t> buffer;
+
+        void moveFrom(MappedFile & other);
+    };
+}
+
+#endif // JACY_FS_MAPPEDFILE_H
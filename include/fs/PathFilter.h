@@ -0,0 +1,63 @@
+#ifndef JACY_FS_PATHFILTER_H
+#define JACY_FS_PATHFILTER_H
+
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace jc::fs {
+    namespace std_fs = std::filesystem;
+
+    /// PathFilter
+    /// @brief Include and exclude globs of project discovery, evaluated by directory walk
+    /// Patterns use `.gitignore`-like syntax, paths are matched relatively to the walk root:
+    ///  - `*` matches any characters but `/`, `?` matches one of them, `**` matches any characters including `/`
+    ///  - pattern with `/` is anchored to the root (leading `/` is dropped), pattern without it matches entry name
+    ///  - trailing `/` makes pattern match only directories
+    ///  - `!` before exclude pattern re-includes entries excluded by previous patterns, the last matching one wins
+    /// Excluded directory is pruned, it is never opened. Include patterns are checked only for files,
+    ///  if there are any, file must match at least one of them.
+    class PathFilter {
+    public:
+        constexpr static auto IGNORE_FILE = ".jacyignore";
+
+        PathFilter() = default;
+        explicit PathFilter(const std_fs::path & root);
+
+        void addInclude(const std::string & pattern);
+        void addExclude(const std::string & pattern);
+
+        /// Add exclude patterns of ignore file, one per line, empty lines and lines starting with `#` are skipped
+        void addIgnoreFile(std::string_view contents);
+
+        bool excludesDir(const std_fs::path & dir) const;
+        bool excludesFile(const std_fs::path & file) const;
+
+        bool empty() const {
+            return includes.empty() and excludes.empty();
+        }
+
+        /// Text of all patterns, listings of walks with different patterns differ
+        std::string fingerprint() const;
+
+        static bool globMatch(std::string_view pattern, std::string_view path);
+
+    private:
+        struct Rule {
+            std::string pattern;
+            bool negated{false};
+            bool dirOnly{false};
+            bool anchored{false};
+        };
+
+        std_fs::path root{"."};
+        std::vector<Rule> includes;
+        std::vector<Rule> excludes;
+
+        static Rule makeRule(std::string pattern, bool allowNegation);
+        static bool ruleMatches(const Rule & rule, const std::string & rel, const std::string & name, bool isDir);
+        bool excluded(const std_fs::path & path, bool isDir) const;
+    };
+}
+
+#endif // JACY_FS_PATHFILTER_H
@@ -0,0 +1,93 @@
+#ifndef JACY_FS_SOURCELOADER_H
+#define JACY_FS_SOURCELOADER_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "fs/Vfs.h"
+
+namespace jc::fs {
+    /// SourceLoader
+    /// @brief Loads all source files of party in background while they are parsed one by one
+    /// `io_uring` backend submits opens, stats and closes of all files in batches, so metadata requests
+    ///  are queued together instead of one blocking syscall per file. Contents are still memory-mapped
+    ///  from the opened descriptor with read-ahead advice, as by other backend, so no file is copied.
+    /// If `io_uring` is unavailable (other OS, old kernel, disabled by seccomp or files are not on disk),
+    ///  files are read from `Vfs` on a thread pool, mapped files get read-ahead advice.
+    /// Content hash of file is computed by the thread which loaded it, right before the file is published.
+    /// Files are published as soon as they are loaded, `take` blocks only until the requested file is ready.
+    /// Files must be taken in order of `paths`, at most `window` loaded files wait to be taken (unbounded if `0`).
+    class SourceLoader {
+    public:
+        enum class Backend {
+            Uring,
+            Threads,
+        };
+
+        struct HashingStats {
+            size_t files{0};
+            size_t bytes{0};
+            /// Sum of hashing time of all loading threads
+            double ms{0};
+        };
+
+        SourceLoader(
+            vfs_ptr vfs,
+            std::vector<std_fs::path> paths,
+            size_t workers,
+            bool allowUring = true,
+            size_t window = 0
+        );
+        ~SourceLoader();
+
+        SourceLoader(const SourceLoader&) = delete;
+        SourceLoader & operator=(const SourceLoader&) = delete;
+
+        /// Wait until file at `index` of `paths` is loaded and take its contents
+        LoadedFile take(size_t index);
+
+        /// Backend is chosen by loader thread, waits until `io_uring` setup either succeeds or fails
+        Backend getBackend();
+
+        static std::string backendToString(Backend backend);
+
+        /// Producer stall is time loader waited for window, consumer stall is time `take` waited for file
+        utils::thread::QueueStats getStats();
+
+        HashingStats getHashingStats();
+
+    private:
+        vfs_ptr vfs;
+        std::vector<std_fs::path> paths;
+        size_t workers;
+
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable loaded;
+        std::condition_variable windowMoved;
+        std::vector<LoadedFile> files;
+        std::vector<bool> ready;
+        size_t window;
+        size_t readyCount{0};
+        size_t takenCount{0};
+        bool stopping{false};
+        utils::thread::QueueStats stats;
+        HashingStats hashingStats;
+        Backend backend{Backend::Threads};
+        bool backendChosen{false};
+
+        void chooseBackend(Backend chosen);
+        void publish(size_t index, LoadedFile && file);
+
+        /// Block until file at `index` fits the window
+        void waitWindow(size_t index);
+        bool fitsWindow(size_t index) const;
+        void loadWithThreads();
+
+        /// Returns `false` if `io_uring` cannot be set up, backend is not chosen and nothing is published then
+        bool loadWithUring();
+    };
+}
+
+#endif // JACY_FS_SOURCELOADER_H
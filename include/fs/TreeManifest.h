@@ -0,0 +1,110 @@
+#ifndef JACY_FS_TREEMANIFEST_H
+#define JACY_FS_TREEMANIFEST_H
+
+#include <vector>
+#include <unordered_map>
+#include <filesystem>
+
+#include "data_types/Option.h"
+#include "utils/hash.h"
+
+namespace jc::fs {
+    namespace std_fs = std::filesystem;
+
+    /// Metadata of file or directory, `mtime` is in nanoseconds
+    struct FileStat {
+        int64_t mtime{0};
+        uint64_t size{0};
+
+        bool operator==(const FileStat & other) const {
+            return mtime == other.mtime and size == other.size;
+        }
+    };
+
+    /// TreeManifest
+    /// @brief Directory tree of previous run with metadata and content hashes of files
+    /// Directory which mtime is unchanged has the same entries, so it is not listed again.
+    /// File which mtime and size are unchanged keeps its content hash, so it is not read to be identified.
+    /// Manifest is rebuilt by each walk, entries of removed files and directories are dropped.
+    /// Entry changed at or after start of the walk which recorded it may be changed again with the same mtime,
+    ///  so it is not reused by the next walk (like racily clean entries of git index).
+    class TreeManifest {
+        constexpr static uint32_t MAGIC = 0x4D52544A; // "JTRM"
+        constexpr static uint32_t VERSION = 3;
+        constexpr static uint32_t NO_PARENT = UINT32_MAX;
+
+    public:
+        struct Listing {
+            std::vector<std_fs::path> files;
+            std::vector<std_fs::path> subdirs;
+        };
+
+        struct Stats {
+            size_t dirsListed{0};
+            size_t dirsReused{0};
+            size_t files{0};
+            size_t filesChanged{0};
+        };
+
+        /// Load manifest of the walk of `root` with `allowedExt` and path filter which fingerprint is `filterKey`,
+        ///  returns `false` if there's no valid one. Root is compared as normalized by `fs::normalizeDir`.
+        bool load(
+            const std_fs::path & path,
+            const std_fs::path & root,
+            const std::string & allowedExt,
+            const std::string & filterKey
+        );
+        bool save(const std_fs::path & path) const;
+
+        /// Single `stat` call, `None` if file does not exist
+        static dt::Option<FileStat> stat(const std_fs::path & path);
+
+        // Walk //
+
+        /// Start new walk, entries of previous run are looked up until `endWalk`
+        void beginWalk(const std_fs::path & root, const std::string & allowedExt, const std::string & filterKey);
+        void endWalk();
+
+        /// Listing of directory from previous run if its mtime is unchanged and is before start of previous walk
+        const Listing * findListing(const std_fs::path & dir, int64_t mtime) const;
+
+        void setDir(const std_fs::path & dir, int64_t mtime, Listing && listing, bool reused);
+        void setFile(const std_fs::path & file, const FileStat & stat);
+
+        // Content hashes //
+        dt::Option<utils::hash::Hash128> getHash(const std_fs::path & file) const;
+        void setHash(const std_fs::path & file, const utils::hash::Hash128 & hash);
+
+        const Stats & getStats() const {
+            return stats;
+        }
+
+    private:
+        struct DirRecord {
+            int64_t mtime{0};
+            Listing listing;
+        };
+
+        struct FileRecord {
+            FileStat stat;
+            dt::Option<utils::hash::Hash128> hash{dt::None};
+        };
+
+        std_fs::path root;
+        std::string allowedExt;
+        std::string filterKey;
+        /// Start of walk which recorded entries, in units of `FileStat::mtime`
+        int64_t walkStart{0};
+        std::unordered_map<std::string, DirRecord> dirs;
+        std::unordered_map<std::string, FileRecord> files;
+
+        // Entries of previous run while walk is in progress
+        int64_t prevWalkStart{0};
+        std::unordered_map<std::string, DirRecord> prevDirs;
+        std::unordered_map<std::string, FileRecord> prevFiles;
+
+        Stats stats;
+    };
+}
+
+#endif // JACY_FS_TREEMANIFEST_H
@@ -0,0 +1,140 @@
+#ifndef JACY_FS_VFS_H
+#define JACY_FS_VFS_H
+
+#include <map>
+
+#include "fs/fs.h"
+#include "fs/MappedFile.h"
+#include "fs/PathFilter.h"
+#include "utils/hash.h"
+
+namespace jc::fs {
+    class Vfs;
+    using vfs_ptr = std::shared_ptr<Vfs>;
+
+    /// Contents of loaded file, either mapped or read into owned buffer
+    struct LoadedFile {
+        std::unique_ptr<MappedFile> mapping;
+        /// Buffer shared with filesystem it is read from (e.g. `MemoryVfs`), so reading never copies it
+        std::shared_ptr<const std::string> contents;
+        bool ok{false};
+
+        /// Set by `SourceLoader` as soon as contents are loaded
+        utils::hash::Hash128 contentHash;
+
+        std::string_view view() const {
+            return mapping
+                ? std::string_view(reinterpret_cast<const char*>(mapping->data()), mapping->size())
+                : contents ? std::string_view(*contents) : std::string_view();
+        }
+    };
+
+    /// Vfs
+    /// @brief Filesystem compiler reads party sources from
+    /// Paths are interpreted as by disk filesystem, directory listing has the layout of `fs::readDirRec`.
+    class Vfs {
+    public:
+        virtual ~Vfs() = default;
+
+        /// Entry of existing file without reading its contents
+        virtual entry_ptr fileEntry(const std_fs::path & path) const = 0;
+
+        /// Recursively list directory, see `fs::readDirRec`, `manifest` is used only by filesystems with metadata
+        virtual entry_ptr readDirRec(
+            const std_fs::path & path,
+            const std::string & allowedExt,
+            size_t workers,
+            const PathFilter * filter,
+            TreeManifest * manifest
+        ) const = 0;
+
+        /// Read whole file, `LoadedFile::ok` is `false` if it cannot be read. Must be safe to call concurrently.
+        virtual LoadedFile read(const std_fs::path & path) const = 0;
+
+        /// Files of disk filesystem can be read by OS-specific batched I/O and watched for changes
+        virtual bool isDisk() const {
+            return false;
+        }
+
+        /// Loaded files are memory-mapped, batched I/O is used only then, as it maps files too
+        virtual bool mapsFiles() const {
+            return false;
+        }
+    };
+
+    /// DiskVfs
+    /// @brief Real filesystem, files are memory-mapped
+    /// Access to mapped file truncated in place faults, so files which may be rewritten while they are in use
+    ///  (e.g. sources kept between watch iterations) are read into owned buffers instead.
+    class DiskVfs : public Vfs {
+    public:
+        explicit DiskVfs(bool mapFiles = true) : mapFiles(mapFiles) {}
+
+        entry_ptr fileEntry(const std_fs::path & path) const override;
+        entry_ptr readDirRec(
+            const std_fs::path & path,
+            const std::string & allowedExt,
+            size_t workers,
+            const PathFilter * filter,
+            TreeManifest * manifest
+        ) const override;
+        LoadedFile read(const std_fs::path & path) const override;
+
+        bool isDisk() const override {
+            return true;
+        }
+
+        bool mapsFiles() const override {
+            return mapFiles;
+        }
+
+    private:
+        bool mapFiles;
+    };
+
+    /// MemoryVfs
+    /// @brief Filesystem of in-memory buffers, e.g. generated code or party preloaded to benchmark pure frontend
+    /// Directories exist implicitly as prefixes of file paths. Files must not be added while compiler reads them.
+    class MemoryVfs : public Vfs {
+    public:
+        void addFile(const std_fs::path & path, std::string contents);
+
+        /// Copy files with `allowedExt` extension (any if empty) of disk directory tree, hidden directories are skipped.
+        /// Ignore file of `dir` is copied too, so project discovery is the same as on disk.
+        static std::shared_ptr<MemoryVfs> fromDisk(const std_fs::path & dir, const std::string & allowedExt);
+
+        entry_ptr fileEntry(const std_fs::path & path) const override;
+        entry_ptr readDirRec(
+            const std_fs::path & path,
+            const std::string & allowedExt,
+            size_t workers,
+            const PathFilter * filter,
+            TreeManifest * manifest
+        ) const override;
+        LoadedFile read(const std_fs::path & path) const override;
+
+        size_t getFilesCount() const {
+            return files.size();
+        }
+
+    private:
+        using file_map = std::map<std_fs::path, std::shared_ptr<const std::string>>;
+
+        /// Files by normalized path, paths are compared element-wise, so files of directory subtree are contiguous
+        file_map files;
+
+        static std_fs::path normalize(const std_fs::path & path);
+
+        /// Build directory of files `[first, last)`, which are all inside `dir` having `depth` elements
+        static entry_ptr buildDir(
+            const std_fs::path & dir,
+            size_t depth,
+            file_map::const_iterator first,
+            file_map::const_iterator last,
+            const std::string & allowedExt,
+            const PathFilter * filter
+        );
+    };
+}
+
+#endif // JACY_FS_VFS_H
@@ -0,0 +1,50 @@
+#ifndef JACY_FS_WATCHER_H
+#define JACY_FS_WATCHER_H
+
+#include <chrono>
+#include <unordered_map>
+
+#include "fs/Entry.h"
+
+namespace jc::fs {
+    /// Watcher
+    /// @brief Recursive watch of directory tree for changes of source files
+    /// Uses inotify, new subdirectories are watched as soon as they are created.
+    /// Hidden directories (e.g. `.jacy-cache`) are not watched, so compiler output never triggers rebuild.
+    /// If events are lost on inotify queue overflow, root directory is reported as changed.
+    class Watcher {
+    public:
+        /// Only changes of files with `allowedExt` extension (any if empty) and directories are reported
+        Watcher(const std_fs::path & root, const std::string & allowedExt);
+        ~Watcher();
+
+        Watcher(const Watcher&) = delete;
+        Watcher & operator=(const Watcher&) = delete;
+
+        /// Returns `false` if inotify is not available
+        bool isOpen() const {
+            return fd >= 0;
+        }
+
+        /// Block until some files are changed, created or removed.
+        /// Changes coming within `debounce` after the previous one are collected together,
+        ///  so editor saving file in several steps gives one batch. Paths are normalized and unique.
+        /// Changed directory means that any file inside of it may be changed.
+        std::vector<std_fs::path> wait(std::chrono::milliseconds debounce);
+
+    private:
+        common::Logger log{"Watcher"};
+        int fd{-1};
+        std_fs::path root;
+        std::string allowedExt;
+        std::unordered_map<int, std_fs::path> watches;
+
+        void addWatchRec(const std_fs::path & dir);
+
+        /// Read available events, waits at most `timeoutMs` (forever if negative) for the first one.
+        /// Returns `false` on timeout.
+        bool readEvents(std::vector<std_fs::path> & changed, int timeoutMs);
+    };
+}
+
+#endif // JACY_FS_WATCHER_H
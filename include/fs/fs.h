@@ -2,10 +2,14 @@
 #define JACY_UTILS_FS_H
 
 #include "fs/Entry.h"
+#include "utils/thread.h"
 
 namespace jc::fs {
     using path = std_fs::path;
 
+    class TreeManifest;
+    class PathFilter;
+
     /**
      * @brief Check if path exists relatively to current dir
      * @param path
@@ -13,11 +17,37 @@ namespace jc::fs {
      */
     bool exists(const std_fs::path & path);
 
-    entry_ptr readfile(const std_fs::path & path);
+    /// Lexically normal directory path without trailing separator, current directory (empty path) is `.`.
+    /// Walk records directories by paths built from it, so root of walk must be normalized by it everywhere.
+    std_fs::path normalizeDir(const std_fs::path & path);
+
+    /// Checks if lexically normal `path` is strictly inside of directory `dir` normalized by `normalizeDir`,
+    ///  `.` contains every relative path which does not go up.
+    bool isInsideDir(const std_fs::path & path, const std_fs::path & dir);
+
+    /// Entry of existing file without reading its contents
+    entry_ptr fileEntry(const std_fs::path & path);
 
-    entry_list readdirRecEntries(const std_fs::path & path, const std::string & allowedExt = "");
+    /// Recursively list directory, only files with `allowedExt` extension (any if empty) are included.
+    /// Directories are listed on `workers` threads, file contents are not read.
+    /// Entries of each directory are sorted: subdirectories first, then files, both by path.
+    /// Entries excluded by `filter` are skipped while directory is listed, so excluded subtree is never opened.
+    entry_list readdirRecEntries(
+        const std_fs::path & path,
+        const std::string & allowedExt = "",
+        size_t workers = 1,
+        const PathFilter * filter = nullptr
+    );
 
-    entry_ptr readDirRec(const std_fs::path & path, const std::string & allowedExt = "");
+    /// With `manifest`, directory which mtime is unchanged since previous walk is not listed again
+    ///  and each file is stat'ed, so the walk is recorded with metadata of files.
+    entry_ptr readDirRec(
+        const std_fs::path & path,
+        const std::string & allowedExt = "",
+        size_t workers = 1,
+        const PathFilter * filter = nullptr,
+        TreeManifest * manifest = nullptr
+    );
 }
 
 #endif // JACY_UTILS_HASH_H
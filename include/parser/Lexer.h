@@ -20,12 +20,12 @@ namespace jc::parser {
         Lexer();
         virtual ~Lexer() = default;
 
-        token_list lex(const parse_sess_ptr & parseSess, std::string source);
+        token_list lex(const parse_sess_ptr & parseSess, std::string_view source);
 
     private:
         common::Logger log{"lexer"};
 
-        std::string source;
+        std::string_view source;
         token_list tokens;
 
         // Lexer current position
@@ -34,6 +34,7 @@ namespace jc::parser {
 
         // Token start position
         Location tokenLoc;
+        uint64_t tokenStartIndex{0};
 
         char peek();
         char lookup(uint8_t distance = 1);
@@ -63,6 +63,14 @@ namespace jc::parser {
         const std::vector<TokenKind> ops;
     };
 
+    /// Binary operator waiting for its right-hand side in iterative `precParse`
+    struct PrecFrame {
+        expr_ptr lhs;
+        Token op;
+        Span begin;
+        uint8_t ceiling;
+    };
+
     enum class BlockArrow : int8_t {
         Just, // Block as standalone expression
         NotAllowed, // Arrow not allowed (error)
@@ -198,7 +206,7 @@ namespace jc::parser {
         expr_ptr parseExpr(const std::string & suggMsg);
         pure_expr_ptr parseLambda();
         opt_expr_ptr assignment();
-        opt_expr_ptr precParse(uint8_t index);
+        opt_expr_ptr precParse();
 
         const static std::vector<PrecParser> precTable;
 
@@ -260,6 +268,24 @@ namespace jc::parser {
             return option.unwrap();
         }
 
+        // Nesting //
+        /// Counts nesting of recursively parsed expressions, limited by `-max-nesting`
+        struct NestingGuard {
+            explicit NestingGuard(uint32_t & depth) : depth(depth) {
+                depth++;
+            }
+
+            ~NestingGuard() {
+                depth--;
+            }
+
+            uint32_t & depth;
+        };
+
+        uint32_t nestingDepth{0};
+        uint32_t maxNesting{0};
+        expr_ptr recoverTooDeepNesting();
+
         /// Shortcut for `peek().span`
         Span cspan() const;
         Span nspan() const;
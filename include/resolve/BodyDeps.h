@@ -0,0 +1,105 @@
+#ifndef JACY_RESOLVE_BODYDEPS_H
+#define JACY_RESOLVE_BODYDEPS_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "resolve/PathResolver.h"
+#include "span/Span.h"
+
+namespace jc::resolve {
+    /// Module-level lookup made while resolving a body, failed lookups are recorded with `NONE_NODE_ID` result.
+    /// Module is referred by its path from party root, `ModNode`s don't survive module tree rebuilding.
+    struct ModLookup {
+        path_segs modPath;
+        bool global;
+        Namespace ns;
+        path_segs segs;
+        node_id res;
+
+        bool operator==(const ModLookup & other) const {
+            return global == other.global and ns == other.ns and modPath == other.modPath and segs == other.segs;
+        }
+
+        bool operator<(const ModLookup & other) const {
+            if (global != other.global) {
+                return global < other.global;
+            }
+            if (ns != other.ns) {
+                return ns < other.ns;
+            }
+            if (modPath != other.modPath) {
+                return modPath < other.modPath;
+            }
+            return segs < other.segs;
+        }
+    };
+
+    struct LocalDecl {
+        node_id declId;
+        node_id nameId;
+        span::Symbol name;
+    };
+
+    /// Resolution record of a body -- top-level item of file
+    struct BodyRecord {
+        node_id bodyId;
+
+        /// All paths visited in body, resolved or not, their resolutions are dropped on re-resolution
+        std::vector<node_id> paths;
+        std::vector<LocalDecl> locals;
+
+        /// Deduplicated module lookups, body is stale if any of them gives another result
+        std::vector<ModLookup> lookups;
+    };
+
+    /// BodyDeps
+    /// @brief Dependencies of bodies on module tree, recorded by `NameResolver` for incremental re-resolution
+    /// Bodies are stored per file in order of items.
+    class BodyDeps {
+    public:
+        BodyDeps() = default;
+
+        void clear() {
+            files.clear();
+        }
+
+        void setFileBodies(span::file_id_t fileId, std::vector<BodyRecord> && bodies) {
+            files[fileId] = std::move(bodies);
+        }
+
+        std::vector<BodyRecord> & getFileBodies(span::file_id_t fileId) {
+            return files[fileId];
+        }
+
+        bool hasFile(span::file_id_t fileId) const {
+            return files.find(fileId) != files.end();
+        }
+
+        void eraseFile(span::file_id_t fileId) {
+            files.erase(fileId);
+        }
+
+        std::vector<span::file_id_t> getFileIds() const {
+            std::vector<span::file_id_t> ids;
+            ids.reserve(files.size());
+            for (const auto & file : files) {
+                ids.push_back(file.first);
+            }
+            return ids;
+        }
+
+        size_t bodiesCount() const {
+            size_t count = 0;
+            for (const auto & file : files) {
+                count += file.second.size();
+            }
+            return count;
+        }
+
+    private:
+        std::unordered_map<span::file_id_t, std::vector<BodyRecord>> files;
+    };
+}
+
+#endif // JACY_RESOLVE_BODYDEPS_H
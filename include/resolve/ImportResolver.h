@@ -0,0 +1,53 @@
+#ifndef JACY_RESOLVE_IMPORTRESOLVER_H
+#define JACY_RESOLVE_IMPORTRESOLVER_H
+
+#include "session/Session.h"
+#include "suggest/SuggInterface.h"
+#include "data_types/SuggResult.h"
+#include "resolve/PathResolver.h"
+
+namespace jc::resolve {
+    /// ImportResolver
+    /// @brief Builds visible names index of each `ModNode` from its own items and `use` declarations
+    /// Imports are resolved to fixed point, so order of `use` declarations and chains of re-imports don't matter.
+    /// Glob imports are expanded here once, lookups of imported names never walk modules again.
+    class ImportResolver : public sugg::SuggInterface {
+    public:
+        ImportResolver() = default;
+
+        dt::SuggResult<dt::none_t> resolve(const sess::sess_ptr & sess);
+
+    private:
+        common::Logger log{"ImportResolver"};
+        sess::sess_ptr sess;
+        mod_node_ptr root;
+
+        struct Import {
+            mod_node_ptr mod;
+            node_id useTreeId;
+            bool global;
+            path_segs path;
+            bool glob;
+            span::Symbol bindName;
+            bool resolved{false};
+        };
+
+        std::vector<Import> imports;
+
+        void initVisible(const mod_node_ptr & mod);
+        void buildFilters(const mod_node_ptr & mod);
+        void collectImports(const mod_node_ptr & mod);
+        void collectUseTree(
+            const mod_node_ptr & mod,
+            const ast::use_tree_ptr & maybeUseTree,
+            bool global,
+            const path_segs & prefix
+        );
+        bool appendPath(const ast::simple_path_ptr & path, path_segs & segs);
+
+        /// Applies import to visible names of its module, returns `true` if new names became visible
+        bool applyImport(Import & import);
+    };
+}
+
+#endif // JACY_RESOLVE_IMPORTRESOLVER_H
@@ -2,12 +2,16 @@
 #define JACY_RESOLVE_MODULESTACK_H
 
 #include "ast/Party.h"
+#include "data_types/FlatMap.h"
+#include "data_types/BloomFilter.h"
+#include "span/Symbol.h"
 
 namespace jc::resolve {
     struct ModNode;
     using ast::node_id;
-    using mod_ns_map = std::map<std::string, node_id>;
     using mod_node_ptr = std::shared_ptr<ModNode>;
+    using mod_ns_map = dt::FlatMap<span::Symbol, node_id>;
+    using mod_children_map = dt::FlatMap<span::Symbol, mod_node_ptr>;
 
     enum class Namespace {
         Value,
@@ -15,15 +19,46 @@ namespace jc::resolve {
         Lifetime, // Not used by `ModNode`
     };
 
+    /// Definition loaded from module metadata of precompiled party, it has node id but no AST node
+    struct ExternDef {
+        span::Symbol name;
+        ast::ItemKind kind;
+        /// Count of function parameters or struct fields
+        uint16_t arity;
+        span::Symbol file;
+        span::span_pos_t pos;
+        span::span_len_t len;
+    };
+
     struct ModNode {
         ModNode(dt::Option<mod_node_ptr> parent) : parent(parent) {}
 
         dt::Option<mod_node_ptr> parent;
-        std::map<std::string, mod_node_ptr> children{};
+        mod_children_map children{};
+
+        /// Path from party root, identifies module between module tree rebuildings
+        std::vector<span::Symbol> path;
 
         mod_ns_map valueNS;
         mod_ns_map typeNS;
 
+        /// `use` declarations of module, resolved by `ImportResolver`
+        std::vector<node_id> useDecls;
+
+        /// Visible names index: own items and children plus names imported by `use` declarations,
+        ///  glob imports are already expanded, so name lookup in module is a single hash probe.
+        mod_ns_map visibleValueNS;
+        mod_ns_map visibleTypeNS;
+        mod_children_map visibleMods;
+
+        /// Negative-lookup filters over visible names index, most of lookups in module miss,
+        ///  filter rejects them without probing the map. Built by `buildFilters` when index is complete.
+        dt::BloomFilter visibleValueFilter;
+        dt::BloomFilter visibleTypeFilter;
+        dt::BloomFilter visibleModsFilter;
+
+        void buildFilters();
+
         mod_ns_map & getNS(Namespace ns) {
             switch (ns) {
                 case Namespace::Value: return valueNS;
@@ -33,6 +68,26 @@ namespace jc::resolve {
                 }
             }
         }
+
+        mod_ns_map & getVisibleNS(Namespace ns) {
+            switch (ns) {
+                case Namespace::Value: return visibleValueNS;
+                case Namespace::Type: return visibleTypeNS;
+                default: {
+                    common::Logger::devPanic("Invalid `ModNode` visible namespace specified");
+                }
+            }
+        }
+
+        const dt::BloomFilter & getVisibleFilter(Namespace ns) const {
+            switch (ns) {
+                case Namespace::Value: return visibleValueFilter;
+                case Namespace::Type: return visibleTypeFilter;
+                default: {
+                    common::Logger::devPanic("Invalid `ModNode` visible namespace filter specified");
+                }
+            }
+        }
     };
 
     struct ModulePrinter {
@@ -43,6 +98,7 @@ namespace jc::resolve {
     private:
         common::Logger log{"ModulePrinter"};
 
+        void printNS(const std::string & title, const mod_ns_map & ns);
         void printIndent();
         uint32_t indent{0};
     };
@@ -0,0 +1,73 @@
+#ifndef JACY_RESOLVE_MODULEMETA_H
+#define JACY_RESOLVE_MODULEMETA_H
+
+#include <filesystem>
+
+#include "session/Session.h"
+#include "fs/MappedFile.h"
+
+namespace jc::resolve {
+    /// ModuleMeta
+    /// @brief Binary module metadata of precompiled party, loaded in place of parsing party sources
+    /// Layout, little-endian, offsets are from the file start:
+    ///  - `Header`
+    ///  - `ModRecord[modulesCount]`, modules in pre-order with children ordered by name, root module is the first
+    ///  - `DefRecord[defsCount]`, definitions grouped by module, ordered by name in each namespace
+    ///  - String table, string is referred by offset of its `u32` length followed by chars
+    /// All records are fixed-size and 4-byte aligned, so mapped file is read in place without parsing.
+    /// Only own names of modules are stored, imports of precompiled party are not re-exported.
+    class ModuleMeta {
+    public:
+        constexpr static uint32_t MAGIC = 0x4D434A2E; // ".JCM"
+        constexpr static uint32_t VERSION = 1;
+        constexpr static uint32_t NO_PARENT = UINT32_MAX;
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t partyName;
+            uint32_t modulesOffset;
+            uint32_t modulesCount;
+            uint32_t defsOffset;
+            uint32_t defsCount;
+            uint32_t stringsOffset;
+            uint32_t stringsSize;
+        };
+
+        struct ModRecord {
+            uint32_t name;
+            uint32_t parent;
+            uint32_t firstDef;
+            uint32_t defsCount;
+        };
+
+        struct DefRecord {
+            uint32_t name;
+            uint32_t file;
+            uint32_t pos;
+            uint32_t len;
+            uint8_t ns;
+            uint8_t kind;
+            uint16_t arity;
+        };
+
+        /// Serialize module tree, modules of other precompiled parties mounted into it are skipped
+        static bool write(
+            const sess::sess_ptr & sess,
+            const mod_node_ptr & root,
+            const std::string & partyName,
+            const std::filesystem::path & path
+        );
+
+        /// Load module tree of precompiled party, definitions get ids reserved in session `NodeMap`
+        ///  and are registered in `Session::externDefs`. On failure `error` is set.
+        static dt::Option<mod_node_ptr> load(
+            const sess::sess_ptr & sess,
+            const std::filesystem::path & path,
+            span::Symbol & partyName,
+            std::string & error
+        );
+    };
+}
+
+#endif // JACY_RESOLVE_MODULEMETA_H
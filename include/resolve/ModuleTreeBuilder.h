@@ -24,6 +24,7 @@ namespace jc::resolve {
         void visit(const ast::Struct & _struct) override;
         void visit(const ast::Trait & trait) override;
         void visit(const ast::TypeAlias & typeAlias) override;
+        void visit(const ast::UseDecl & useDecl) override;
 
 //        void visit(const ast::Struct & _struct) override;
 
@@ -35,10 +36,11 @@ namespace jc::resolve {
 
         // Modules //
     private:
+        sess::sess_ptr sess;
         mod_node_ptr mod;
         void declare(Namespace ns, const ast::id_ptr & ident, node_id nodeId);
 
-        void enterMod(const std::string & name, const dt::Option<span::Span> & nameSpan);
+        void enterMod(span::Symbol name, const dt::Option<span::Span> & nameSpan);
         void exitMod();
     };
 }
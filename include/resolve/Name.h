@@ -3,18 +3,15 @@
 
 #include "ast/Node.h"
 #include "resolve/Module.h"
+#include "span/Symbol.h"
 
 namespace jc::resolve {
     using ast::node_id;
     using ast::opt_node_id;
     
     struct Name;
-    struct Rib;
-    using rib_ptr = std::shared_ptr<Rib>;
-    using opt_rib = dt::Option<rib_ptr>;
-    using rib_stack = std::vector<rib_ptr>;
-    using name_ptr = std::shared_ptr<Name>;
-    using ns_map = std::map<std::string, name_ptr>;
+    struct Binding;
+    using opt_binding = dt::Option<Binding>;
 
     struct Name {
         enum class Kind {
@@ -122,27 +119,65 @@ namespace jc::resolve {
             }
             return "meow, bitch";
         }
+
+        static Namespace getNS(Kind kind);
     };
 
-    using decl_result = dt::Option<name_ptr>;
+    /// Binding
+    /// @brief Currently visible name and depth of the rib it was declared in
+    struct Binding {
+        Name::Kind kind;
+        node_id nodeId;
+        uint32_t ribDepth;
+    };
 
+    /// Rib
+    /// @brief Scope marker, holds size of `ScopeTable` undo log at the moment the rib was entered
     struct Rib {
         enum class Kind {
             Raw,
         } kind;
 
-        // TODO: Use `Ident{node_id, string}` instead of string as key
-        ns_map typeNS;
-        ns_map valueNS;
-        ns_map lifetimeNS;
+        size_t undoMark;
+    };
 
-        /// Declare new name.
-        /// Returns kind and node_id of node that was already declared if it was
-        decl_result declare(const std::string & name, Name::Kind kind, node_id nodeId);
+    /// ScopeTable
+    /// @brief Flat binding table with undo log
+    /// Each namespace maps a name to its innermost visible binding, so lookup is a single hash probe.
+    /// Declaration records the shadowed binding (if any) in undo log, exiting rib rolls log back to rib mark,
+    ///  thus memory is bounded by count of visible names, not by count of names in program.
+    class ScopeTable {
+    public:
+        ScopeTable() = default;
+
+        void enterRib(Rib::Kind kind = Rib::Kind::Raw);
+        void exitRib();
+        uint32_t getDepth() const;
+        void clear();
+
+        /// Declare new name in current rib.
+        /// Returns binding that was already declared in the same rib if it cannot be shadowed
+        opt_binding declare(span::Symbol name, Name::Kind kind, node_id nodeId);
+
+        opt_binding lookup(Namespace ns, span::Symbol name) const;
+
+    private:
+        using binding_map = dt::FlatMap<span::Symbol, Binding>;
+
+        struct UndoEntry {
+            Namespace ns;
+            span::Symbol name;
+            opt_binding shadowed;
+        };
 
-        ns_map & getNSForName(Name::Kind kind);
+        binding_map valueNS;
+        binding_map typeNS;
+        binding_map lifetimeNS;
+        std::vector<UndoEntry> undoLog;
+        std::vector<Rib> ribs;
 
-        explicit Rib(Kind kind) : kind(kind) {}
+        binding_map & getNS(Namespace ns);
+        const binding_map & getNS(Namespace ns) const;
     };
 }
 
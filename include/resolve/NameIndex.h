@@ -0,0 +1,56 @@
+#ifndef JACY_RESOLVE_NAMEINDEX_H
+#define JACY_RESOLVE_NAMEINDEX_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "span/Symbol.h"
+
+namespace jc::resolve {
+    /// NameIndex
+    /// @brief SymSpell-style deletion index over interned symbols for "did you mean" suggestions
+    /// For each symbol all strings obtained by deleting up to `MAX_DISTANCE` chars of its prefix are indexed,
+    ///  query generates deletes of the misspelled name, so candidates are found without scanning all names.
+    /// Candidates are verified by full edit distance, the caller filters them by visibility.
+    /// Index is built lazily on first query and extended with symbols interned after it, queries are thread-safe.
+    class NameIndex {
+        constexpr static uint32_t MAX_DISTANCE = 2;
+        constexpr static size_t PREFIX_LEN = 7;
+
+    public:
+        NameIndex() = default;
+
+        struct Candidate {
+            span::Symbol sym;
+            uint32_t distance;
+        };
+
+        /// Symbols similar to `name`, sorted by edit distance and then by string.
+        /// Allowed distance depends on the length of `name`, `name` itself is not included
+        std::vector<Candidate> query(const std::string & name);
+
+        static uint32_t maxDistanceFor(const std::string & name);
+
+        /// Optimal string alignment distance (Damerau-Levenshtein with adjacent transpositions)
+        static uint32_t editDistance(const std::string & lhs, const std::string & rhs);
+
+    private:
+        std::mutex mutex;
+        span::sym_id_t indexedCount{0};
+
+        // Note: Deletes are keyed by hash, collisions only add candidates which are verified anyway
+        std::unordered_map<uint64_t, std::vector<span::sym_id_t>> deletes;
+
+        void update();
+        void add(span::sym_id_t id, const std::string & str);
+
+        template<class F>
+        static void forEachDelete(const std::string & str, F && func);
+
+        static uint64_t hashStr(const std::string & str);
+    };
+}
+
+#endif // JACY_RESOLVE_NAMEINDEX_H
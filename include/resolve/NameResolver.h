@@ -1,12 +1,18 @@
 #ifndef JACY_RESOLVE_NAMERESOLVER_H
 #define JACY_RESOLVE_NAMERESOLVER_H
 
+#include <unordered_set>
+
 #include "ast/StubVisitor.h"
 #include "data_types/SuggResult.h"
 #include "resolve/Name.h"
 #include "utils/arr.h"
 #include "suggest/SuggInterface.h"
 #include "resolve/ResStorage.h"
+#include "resolve/PathResolver.h"
+#include "resolve/BodyDeps.h"
+#include "common/Config.h"
+#include "utils/thread.h"
 
 namespace jc::resolve {
     using common::Logger;
@@ -20,6 +26,16 @@ namespace jc::resolve {
 
         dt::SuggResult<dt::none_t> resolve(const sess::sess_ptr & sess, const ast::Party & party);
 
+        /// Re-resolve party after module tree rebuilding, `changedFiles` are re-parsed files.
+        /// Bodies of changed files are resolved from scratch, bodies of other files are re-resolved
+        ///  only if some of their recorded module lookups gives another result, `ResStorage` is patched in place.
+        /// Only suggestions of re-resolved bodies are reported.
+        dt::SuggResult<dt::none_t> resolveIncremental(
+            const sess::sess_ptr & sess,
+            const ast::Party & party,
+            const std::unordered_set<span::file_id_t> & changedFiles
+        );
+
         void visit(const ast::FileModule & fileModule) override;
         void visit(const ast::DirModule & dirModule) override;
 
@@ -32,7 +48,6 @@ namespace jc::resolve {
 //        void visit(const ast::Trait & trait) override;
 //        void visit(const ast::TypeAlias & typeAlias) override;
         void visit(const ast::UseDecl & useDecl) override;
-        void resolveUseTree(const ast::use_tree_ptr & useTree);
 
         // Statements //
 //        void visit(const ast::ForStmt & forStmt) override;
@@ -53,34 +68,59 @@ namespace jc::resolve {
         common::Logger log{"NameResolver"};
         sess::sess_ptr sess;
 
+        // Parallel resolution //
+    private:
+        /// Resolutions of worker, set right into `resOut` if it is given (incremental resolution)
+        res_shard resShard;
+        ResStorage * resOut{nullptr};
+        void setRes(node_id pathId, node_id res);
+        static void collectFiles(const ast::Module & module, std::vector<const ast::FileModule*> & files);
+        void resolveFile(const ast::FileModule & fileModule, const std::unordered_set<node_id> * onlyBodies = nullptr);
+
+        // Dependencies //
+    private:
+        std::vector<BodyRecord> fileBodies;
+        BodyRecord * curBody{nullptr};
+        void beginBody(node_id bodyId);
+        void endBody();
+        bool isStale(const BodyRecord & body);
+        void dropBody(const BodyRecord & body);
+
         // Extended visitors //
     private:
         void visitItems(const ast::item_list & members);
+        void declareItems(const ast::item_list & members);
         void visitTypeParams(const ast::opt_type_params & maybeTypeParams);
         void visitNamedList(const ast::named_list & namedList);
 
         // Ribs //
     private:
-        rib_stack ribStack;
-        uint32_t depth{0};
-        uint32_t getDepth() const;
-        const rib_ptr & curRib() const;
-        opt_rib ribAt(size_t ribDepth) const;
+        ScopeTable scopes;
         void enterRib(Rib::Kind kind = Rib::Kind::Raw);
         void exitRib();
-        void liftToDepth(size_t prevDepth);
 
         // Modules //
     private:
         mod_node_ptr rootMod;
+        mod_node_ptr curMod;
+        PathResolver pathResolver;
 
         // Declarations //
     private:
-        void declare(const std::string & name, Name::Kind kind, node_id nodeId);
+        void declare(span::Symbol name, Name::Kind kind, node_id nodeId);
 
         // Resolution //
     private:
-        void resolveSimplePath(const ast::simple_path_ptr & simplePath);
+        void resolvePath(Namespace ns, bool global, const path_segs & segs, node_id pathId);
+        std::vector<span::Symbol> findSimilarNames(Namespace ns, bool global, const path_segs & segs);
+
+        // Statistics //
+    private:
+        void logFilterStats(const FilterStats & stats);
+
+        // Lints //
+    private:
+        void lintUnusedLocals(const BodyRecord & body);
 
         // Suggestions //
     private:
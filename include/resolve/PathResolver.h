@@ -0,0 +1,104 @@
+#ifndef JACY_RESOLVE_PATHRESOLVER_H
+#define JACY_RESOLVE_PATHRESOLVER_H
+
+#include <unordered_map>
+
+#include "resolve/Module.h"
+
+namespace jc::resolve {
+    using ast::opt_node_id;
+
+    /// Path as sequence of symbols, `super`, `self` and `party` segments are interned keywords,
+    ///  keywords cannot be identifiers, so they don't clash with names
+    using path_segs = std::vector<span::Symbol>;
+    using opt_mod_node = dt::Option<mod_node_ptr>;
+
+    /// Counters of `ModNode` negative-lookup filters
+    struct FilterStats {
+        /// Probes of filtered maps
+        size_t probes{0};
+        /// Probes rejected by filter without touching the map
+        size_t rejected{0};
+        /// Probes passed by filter that missed in the map
+        size_t falsePositives{0};
+
+        FilterStats & operator+=(const FilterStats & other) {
+            probes += other.probes;
+            rejected += other.rejected;
+            falsePositives += other.falsePositives;
+            return *this;
+        }
+    };
+
+    /// PathResolver
+    /// @brief Resolves module paths (`a::b::c`) over visible names index of `ModNode`s
+    /// Relative path starts in current module, first segment that is not found there is looked up in party root,
+    ///  so sibling files are reachable by name.
+    /// Results (including failures) are memoized by (module, namespace, path), it is valid only after
+    ///  visible names index is complete. Memo is not shared, so each resolver thread has its own `PathResolver`.
+    class PathResolver {
+    public:
+        PathResolver() = default;
+
+        static span::Symbol superSym();
+        static span::Symbol selfSym();
+        static span::Symbol partySym();
+
+        /// Resolve module by path without memoization
+        static opt_mod_node walkModPath(
+            const mod_node_ptr & root,
+            const mod_node_ptr & from,
+            bool global,
+            path_segs::const_iterator begin,
+            path_segs::const_iterator end,
+            FilterStats * stats = nullptr
+        );
+
+        /// Find module by its `ModNode::path` walking children, imports are not considered
+        static opt_mod_node findModByPath(const mod_node_ptr & root, const path_segs & path);
+
+        /// Resolve definition by path without memoization
+        static opt_node_id lookup(
+            const mod_node_ptr & root,
+            const mod_node_ptr & from,
+            bool global,
+            const path_segs & segs,
+            Namespace ns,
+            FilterStats * stats = nullptr
+        );
+
+        static std::string pathToString(bool global, const path_segs & segs);
+
+        void reset(const mod_node_ptr & root);
+
+        /// Memoized `lookup`
+        opt_node_id resolve(const mod_node_ptr & from, bool global, const path_segs & segs, Namespace ns);
+
+        const FilterStats & getFilterStats() const {
+            return filterStats;
+        }
+
+    private:
+        mod_node_ptr root;
+        FilterStats filterStats;
+
+        struct PathKey {
+            const ModNode * from;
+            Namespace ns;
+            bool global;
+            path_segs segs;
+
+            bool operator==(const PathKey & other) const {
+                return from == other.from and ns == other.ns and global == other.global and segs == other.segs;
+            }
+        };
+
+        struct PathKeyHash {
+            size_t operator()(const PathKey & key) const;
+        };
+
+        std::unordered_map<PathKey, opt_node_id, PathKeyHash> memo;
+    };
+}
+
+#endif // JACY_RESOLVE_PATHRESOLVER_H
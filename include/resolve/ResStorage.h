@@ -1,29 +1,75 @@
 #ifndef JACY_INCLUDE_RESOLVE_RESSTORAGE_H
 #define JACY_INCLUDE_RESOLVE_RESSTORAGE_H
 
-#include <map>
+#include <vector>
+#include <utility>
 
 #include "ast/Node.h"
 
 namespace jc::resolve {
     using ast::node_id;
+    using ast::opt_node_id;
+
+    /// Resolutions {path: node} made by one resolver worker in order they were set.
+    /// Shard is sparse, so its size is proportional to paths worker resolved, not to all nodes of party.
+    using res_shard = std::vector<std::pair<node_id, node_id>>;
 
     /// ResStorage
     /// @brief Collection of {path: node} names resolutions
+    /// Resolutions are stored densely by path node id, `NONE_NODE_ID` marks unresolved paths.
+    /// After resolution `buildUses` builds CSR-style reverse index {definition: use-sites},
+    ///  use-sites of definition `d` are `useSites[useOffsets[d] .. useOffsets[d + 1])`.
     class ResStorage {
     public:
         ResStorage() = default;
 
-        node_id getRes(node_id name) const {
-            return resolutions.at(name);
-        }
+        /// Range of use-sites of one definition, valid until next `reset` or `buildUses`
+        struct UseRange {
+            const node_id * first;
+            const node_id * last;
+
+            const node_id * begin() const {
+                return first;
+            }
+
+            const node_id * end() const {
+                return last;
+            }
+
+            size_t size() const {
+                return static_cast<size_t>(last - first);
+            }
+
+            bool empty() const {
+                return first == last;
+            }
+        };
+
+        void reset(size_t nodesCount);
 
-        void setRes(node_id name, node_id res) {
-            resolutions.emplace(name, res);
-        }
+        node_id getRes(node_id name) const;
+        opt_node_id getOptRes(node_id name) const;
+
+        /// Set resolution of path, re-resolution overwrites previous one
+        void setRes(node_id name, node_id res);
+
+        /// Drop resolution of path, used to patch storage when body is re-resolved
+        void clearRes(node_id name);
+
+        size_t resolvedCount() const;
+
+        /// Copy resolutions from shard filled by another resolver, shards must not overlap
+        void merge(const res_shard & shard);
+
+        void buildUses();
+        UseRange getUses(node_id def) const;
 
     private:
-        std::map<node_id, node_id> resolutions;
+        std::vector<node_id> resolutions;
+
+        bool usesBuilt{false};
+        std::vector<uint32_t> useOffsets;
+        std::vector<node_id> useSites;
     };
 }
 
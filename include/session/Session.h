@@ -5,12 +5,17 @@
 #include <memory>
 #include <vector>
 #include <random>
+#include <map>
+#include <unordered_map>
 
 #include "common/Logger.h"
 #include "session/SourceMap.h"
 #include "ast/NodeMap.h"
+#include "ast/ParentIndex.h"
 #include "resolve/Module.h"
 #include "resolve/ResStorage.h"
+#include "resolve/BodyDeps.h"
+#include "resolve/NameIndex.h"
 
 namespace jc::sess {
     struct Session;
@@ -19,8 +24,16 @@ namespace jc::sess {
     struct Session {
         SourceMap sourceMap;
         ast::NodeMap nodeMap;
+        ast::ParentIndex parentIndex;
         dt::Option<resolve::mod_node_ptr> modTreeRoot;
+        std::unordered_map<span::file_id_t, resolve::mod_node_ptr> fileModules;
+
+        /// Module trees of precompiled parties by party name, mounted into module tree root
+        std::map<span::Symbol, resolve::mod_node_ptr> externMods;
+        std::unordered_map<ast::node_id, resolve::ExternDef> externDefs;
         resolve::ResStorage resStorage;
+        resolve::BodyDeps bodyDeps;
+        resolve::NameIndex nameIndex;
     };
 }
 
@@ -1,46 +1,85 @@
 #ifndef JACY_SESSION_SOURCEMAP_H
 #define JACY_SESSION_SOURCEMAP_H
 
-#include <map>
+#include <deque>
 #include <vector>
 #include <functional>
+#include <unordered_map>
 
 #include "utils/map.h"
 #include "utils/hash.h"
 #include "fs/fs.h"
+#include "fs/MappedFile.h"
 #include "data_types/Option.h"
 #include "span/Span.h"
 
 namespace jc::sess {
-    using file_id_t = size_t;
+    using file_id_t = span::file_id_t;
     using line_pos_t = uint32_t;
 
+    /// SourceFile
+    /// @brief Source file contents and line offsets
+    /// Contents are either memory-mapped file or owned string (e.g. for sources not backed by file),
+    ///  `src` is a view into one of them, so contents are never copied after reading.
+    /// Line offsets are computed on first use, so pages of mapped file which tokens were cached are never touched.
     struct SourceFile {
         SourceFile(const fs::path & path) : path(path), src(dt::None) {}
 
         fs::path path;
-        dt::Option<std::string> src;
-        std::vector<line_pos_t> lines;
+        dt::Option<std::string_view> src;
+        mutable std::vector<line_pos_t> lines;
+        mutable bool linesSet{false};
+
+        /// See `utils::hash::contentHash`
+        utils::hash::Hash128 contentHash;
+
+        std::unique_ptr<fs::MappedFile> mapping;
+        std::shared_ptr<const std::string> owned;
+
+        bool isMapped() const {
+            return mapping != nullptr;
+        }
 
         std::string filename() const {
             return path.filename().string();
         }
     };
 
+    /// SourceMap
+    /// @brief Dense table of source files indexed by sequential file id
+    /// Files are stored in `deque`, so references to `SourceFile` stay valid when new files are added.
+    /// Adding already known path returns its id, so re-read file keeps its id.
     struct SourceMap {
         SourceMap() = default;
 
         file_id_t addSource(const fs::path & path);
-        void setSrc(file_id_t fileId, std::string && src);
+        /// Set contents to owned buffer, it may be shared with `Vfs` it is read from
+        void setSrc(file_id_t fileId, std::shared_ptr<const std::string> src, const utils::hash::Hash128 & contentHash);
+
+        /// Set contents to already mapped file, `contentHash` is given as mapped pages may not be read yet
+        void setMappedSrc(
+            file_id_t fileId,
+            std::unique_ptr<fs::MappedFile> && mapping,
+            const utils::hash::Hash128 & contentHash
+        );
         const SourceFile & getSourceFile(file_id_t fileId) const;
+        const std::deque<SourceFile> & getSources() const;
         size_t getLinesCount(file_id_t) const;
 
+        /// Offsets of line beginnings, computed on first call
+        const std::vector<line_pos_t> & getLines(file_id_t fileId) const;
+
         std::string getLine(file_id_t fileId, size_t index) const;
+        size_t getLineIndex(file_id_t fileId, span::span_pos_t pos) const;
 
         std::string sliceBySpan(file_id_t, const span::Span & span);
 
     private:
-        std::map<file_id_t, SourceFile> sources;
+        std::deque<SourceFile> sources;
+        std::unordered_map<std::string, file_id_t> pathIds;
+
+        SourceFile & getSourceFileMut(file_id_t fileId);
+        static void setLines(const SourceFile & sourceFile);
     };
 }
 
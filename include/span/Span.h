@@ -4,45 +4,98 @@
 #include <cstdint>
 #include <iostream>
 #include <algorithm>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
 
 #include "common/Logger.h"
 
 namespace jc::span {
     using span_pos_t = uint32_t;
-    using span_len_t = uint16_t;
-    using file_id_t = size_t;
+    using span_len_t = uint32_t;
+    using file_id_t = uint32_t;
 
+    /// Span
+    /// @brief Compact 8-byte source range
+    /// Inline spans store `len` in 16 bits and `fileId` in 15 bits, the highest bit of `ctx` marks interned span,
+    ///  then `base` is an index in `SpanInterner` holding the full `{pos, len, fileId}` data.
     struct Span {
+        const static span_len_t INLINE_LEN_MAX = UINT16_MAX;
+        const static file_id_t INLINE_FILE_ID_MAX = 0x7FFF;
+        const static uint16_t INTERNED_TAG = 0x8000;
+
         Span() = default;
-        explicit Span(span_pos_t lowBound, span_pos_t highBound, file_id_t fileId) {
-            pos = lowBound;
-            len = static_cast<span_len_t>(highBound - lowBound);
-            this->fileId = fileId;
+        explicit Span(span_pos_t pos, span_len_t len, file_id_t fileId);
+
+        static Span fromBounds(span_pos_t lowBound, span_pos_t highBound, file_id_t fileId) {
+            return Span(lowBound, highBound - lowBound, fileId);
         }
 
-        explicit Span(span_pos_t pos, span_len_t len, file_id_t fileId)
-            : pos(pos), len(len), fileId(fileId) {}
+        span_pos_t getPos() const;
+        span_len_t getLen() const;
+        file_id_t getFileId() const;
 
-        span_pos_t pos{0};
-        span_len_t len{0};
-        file_id_t fileId{0}; // TODO: Context
+        bool isInterned() const {
+            return ctx & INTERNED_TAG;
+        }
 
         std::string toString() const {
-            return std::to_string(pos) + "; len = " + std::to_string(len);
+            return std::to_string(getPos()) + "; len = " + std::to_string(getLen());
         }
 
         span_pos_t getHighBound() const {
-            return pos + len;
+            return getPos() + getLen();
         }
 
         Span to(const Span & end) const {
-            if (end.fileId != fileId) {
+            if (end.getFileId() != getFileId()) {
                 common::Logger::devPanic("Called `Span::to` with spans from different files");
             }
             // FIXME: Here may be problems with different lines
             // FIXME: This does not work
-            return Span(std::min(pos, end.pos), std::max(getHighBound(), end.getHighBound()), fileId);
+            return fromBounds(
+                std::min(getPos(), end.getPos()),
+                std::max(getHighBound(), end.getHighBound()),
+                getFileId()
+            );
         }
+
+    private:
+        span_pos_t base{0};
+        uint16_t len{0};
+        uint16_t ctx{0};
+    };
+
+    /// Full span data for spans that don't fit inline encoding
+    struct SpanData {
+        span_pos_t pos;
+        span_len_t len;
+        file_id_t fileId;
+    };
+
+    /// SpanInterner
+    /// @brief Side table for spans with too long `len` or too large `fileId`
+    /// Shared by all sessions, interning is thread-safe
+    class SpanInterner {
+    public:
+        SpanInterner(SpanInterner const&) = delete;
+        void operator=(SpanInterner const&) = delete;
+
+        static SpanInterner & getInstance() {
+            static SpanInterner instance;
+            return instance;
+        }
+
+        uint32_t intern(const SpanData & data);
+        SpanData get(uint32_t index) const;
+        size_t size() const;
+
+    private:
+        SpanInterner() = default;
+
+        mutable std::mutex mutex;
+        std::vector<SpanData> spans;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> lookup;
     };
 }
 
@@ -0,0 +1,78 @@
+#ifndef JACY_SPAN_SYMBOL_H
+#define JACY_SPAN_SYMBOL_H
+
+#include <cstdint>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace jc::span {
+    using sym_id_t = uint32_t;
+
+    /// Symbol
+    /// @brief Interned identifier, 4 bytes instead of `std::string` stored in each node
+    struct Symbol {
+        Symbol() = default;
+        explicit Symbol(sym_id_t id) : id(id) {}
+
+        static Symbol intern(const std::string & str);
+
+        const std::string & toString() const;
+
+        sym_id_t getId() const {
+            return id;
+        }
+
+        bool operator==(const Symbol & other) const {
+            return id == other.id;
+        }
+
+        bool operator!=(const Symbol & other) const {
+            return id != other.id;
+        }
+
+        bool operator<(const Symbol & other) const {
+            return id < other.id;
+        }
+
+    private:
+        sym_id_t id{0};
+    };
+
+    /// Interner
+    /// @brief Global symbol table, interning is thread-safe
+    /// Strings are stored in `deque` so references returned by `Symbol::toString` stay valid
+    class Interner {
+    public:
+        Interner(Interner const&) = delete;
+        void operator=(Interner const&) = delete;
+
+        static Interner & getInstance() {
+            static Interner instance;
+            return instance;
+        }
+
+        sym_id_t intern(const std::string & str);
+        const std::string & get(sym_id_t id) const;
+        size_t size() const;
+
+    private:
+        Interner();
+
+        mutable std::mutex mutex;
+        std::deque<std::string> strings;
+        std::unordered_map<std::string, sym_id_t> symbols;
+    };
+}
+
+namespace std {
+    template<>
+    struct hash<jc::span::Symbol> {
+        size_t operator()(const jc::span::Symbol & sym) const {
+            return hash<jc::span::sym_id_t>()(sym.getId());
+        }
+    };
+}
+
+#endif // JACY_SPAN_SYMBOL_H
@@ -17,6 +17,10 @@ namespace jc::sugg {
         void suggestWarnMsg(const std::string & msg, const span::Span & span, sugg::eid_t eid = sugg::NoneEID);
         void suggestHelp(const std::string & helpMsg, sugg::sugg_ptr sugg);
 
+        /// Count of collected suggestions, used with `truncateSuggestions` to drop suggestions of some step
+        size_t getSuggestionsCount() const;
+        void truncateSuggestions(size_t count);
+
     private:
         sugg::sugg_list suggestions;
     };
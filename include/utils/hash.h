@@ -2,6 +2,9 @@
 #define JACY_UTILS_HASH_H
 
 #include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
 #include <unordered_map>
 
 namespace jc::utils::hash {
@@ -10,6 +13,110 @@ namespace jc::utils::hash {
         static std::hash<T> hasher;
         return hasher(value);
     }
+
+    /// Hash128
+    /// @brief 128-bit hash value, unlike `std::hash` it is stable between runs and platforms
+    struct Hash128 {
+        uint64_t low{0};
+        uint64_t high{0};
+
+        bool operator==(const Hash128 & other) const {
+            return low == other.low and high == other.high;
+        }
+
+        bool operator!=(const Hash128 & other) const {
+            return not(*this == other);
+        }
+
+        std::string toString() const {
+            static const char * digits = "0123456789abcdef";
+            std::string str(32, '0');
+            for (size_t i = 0; i < 16; i++) {
+                str[15 - i] = digits[(high >> (i * 4)) & 0xF];
+                str[31 - i] = digits[(low >> (i * 4)) & 0xF];
+            }
+            return str;
+        }
+    };
+
+    /// Hasher128
+    /// @brief Streaming 128-bit hasher, two lanes with xxHash64 rounds and avalanche
+    class Hasher128 {
+        constexpr static uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+        constexpr static uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr static uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+
+    public:
+        explicit Hasher128(uint64_t seed = 0) : low(seed + PRIME_1), high(seed - PRIME_2) {}
+
+        Hasher128 & add(uint64_t value) {
+            low = round(low, value);
+            high = round(high, value ^ rotl(low, 27));
+            len++;
+            return *this;
+        }
+
+        Hasher128 & add(std::string_view str) {
+            size_t i = 0;
+            for (; i + sizeof(uint64_t) <= str.size(); i += sizeof(uint64_t)) {
+                uint64_t chunk;
+                std::memcpy(&chunk, str.data() + i, sizeof(uint64_t));
+                add(chunk);
+            }
+            uint64_t tail = 0;
+            std::memcpy(&tail, str.data() + i, str.size() - i);
+            return add(tail).add(static_cast<uint64_t>(str.size()));
+        }
+
+        Hasher128 & add(const Hash128 & hash) {
+            return add(hash.low).add(hash.high);
+        }
+
+        Hash128 digest() const {
+            const auto l = avalanche(low ^ (len * PRIME_3));
+            const auto h = avalanche(high + l);
+            return {l, h};
+        }
+
+    private:
+        uint64_t low;
+        uint64_t high;
+        uint64_t len{0};
+
+        static uint64_t rotl(uint64_t x, int r) {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        static uint64_t round(uint64_t acc, uint64_t input) {
+            acc += input * PRIME_2;
+            acc = rotl(acc, 31);
+            return acc * PRIME_1;
+        }
+
+        static uint64_t avalanche(uint64_t h) {
+            h ^= h >> 33;
+            h *= PRIME_2;
+            h ^= h >> 29;
+            h *= PRIME_3;
+            h ^= h >> 32;
+            return h;
+        }
+    };
+
+    /// Hash of contents of large buffer, e.g. source file
+    /// xxHash3-style: 8 lanes accumulate 64-byte stripes with 32x32-bit multiplications (SSE2 on x86-64),
+    ///  so throughput is bound by memory rather than by multiplication latency.
+    /// Inputs shorter than 256 bytes are hashed by `Hasher128`. Not compatible with xxHash3 digests.
+    Hash128 contentHash(std::string_view data);
+}
+
+namespace std {
+    template<>
+    struct hash<jc::utils::hash::Hash128> {
+        size_t operator()(const jc::utils::hash::Hash128 & hash) const {
+            return static_cast<size_t>(hash.low ^ hash.high);
+        }
+    };
 }
 
 #endif // JACY_UTILS_HASH_H
@@ -0,0 +1,42 @@
+#ifndef JACY_UTILS_STACK_H
+#define JACY_UTILS_STACK_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <type_traits>
+
+namespace jc::utils::stack {
+    /// If less native stack than `RED_ZONE` remains, recursion continues on a new stack segment
+    constexpr size_t RED_ZONE = 256 * 1024;
+    constexpr size_t SEGMENT_SIZE = 8 * 1024 * 1024;
+
+    /// Bytes of native stack remaining for current thread, `SIZE_MAX` if unknown for platform
+    size_t remaining();
+
+    /// Runs `cb` on a new stack segment (a thread with fresh stack joined right away), rethrows its exception
+    void runOnNewSegment(const std::function<void()> & cb);
+
+    /// Segmented-stack continuation: calls `cb` in place while there's enough stack,
+    ///  otherwise on a new segment, so deep recursion costs memory linear to its depth instead of crash.
+    template<class F>
+    auto ensureSufficient(F && cb) -> decltype(cb()) {
+        using R = decltype(cb());
+        if (remaining() >= RED_ZONE) {
+            return cb();
+        }
+
+        if constexpr (std::is_void_v<R>) {
+            runOnNewSegment(cb);
+        } else {
+            std::optional<R> result;
+            runOnNewSegment([&]() {
+                result.emplace(cb());
+            });
+            return std::move(*result);
+        }
+    }
+}
+
+#endif // JACY_UTILS_STACK_H
@@ -0,0 +1,115 @@
+#ifndef JACY_UTILS_THREAD_H
+#define JACY_UTILS_THREAD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+
+namespace jc::utils::thread {
+    /// Task of `parallelFor`, receives index of worker running it and index of the task
+    using task_func = std::function<void(size_t worker, size_t task)>;
+
+    /// Runs tasks `[0, tasksCount)` on a pool of `workers` threads, each worker takes next task when it's done.
+    /// Worker indices are in `[0, workers)`, so callers can keep per-worker state without locks.
+    /// With single worker (or single task) tasks run on the calling thread in order.
+    /// First exception thrown by a task is rethrown after all workers are joined.
+    void parallelFor(size_t workers, size_t tasksCount, const task_func & func);
+
+    /// Counters of queue between two pipeline stages
+    /// Depth is sampled on each push, stalls are times producer waited for free slot
+    ///  and consumer waited for item, so the stage that makes other one wait is the bottleneck.
+    struct QueueStats {
+        size_t capacity{0};
+        size_t pushed{0};
+        size_t maxDepth{0};
+        size_t depthSum{0};
+        double producerStallMs{0};
+        double consumerStallMs{0};
+
+        double avgDepth() const {
+            return pushed == 0 ? 0 : static_cast<double>(depthSum) / static_cast<double>(pushed);
+        }
+    };
+
+    /// Blocking FIFO queue with fixed capacity, producer waits while it is full
+    /// After `close` pushes are rejected and `pop` fails once queue is drained, so neither side blocks forever.
+    template<class T>
+    class BoundedQueue {
+        using clock = std::chrono::steady_clock;
+
+    public:
+        explicit BoundedQueue(size_t capacity) {
+            stats.capacity = std::max<size_t>(1, capacity);
+        }
+
+        /// Returns `false` if queue is closed
+        bool push(T && item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (not closed and items.size() >= stats.capacity) {
+                const auto start = clock::now();
+                notFull.wait(lock, [&]() {
+                    return closed or items.size() < stats.capacity;
+                });
+                stats.producerStallMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            }
+            if (closed) {
+                return false;
+            }
+            items.emplace_back(std::move(item));
+            stats.pushed++;
+            stats.depthSum += items.size();
+            stats.maxDepth = std::max(stats.maxDepth, items.size());
+            lock.unlock();
+            notEmpty.notify_one();
+            return true;
+        }
+
+        /// Returns `false` if queue is closed and empty
+        bool pop(T & item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (items.empty() and not closed) {
+                const auto start = clock::now();
+                notEmpty.wait(lock, [&]() {
+                    return closed or not items.empty();
+                });
+                stats.consumerStallMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            }
+            if (items.empty()) {
+                return false;
+            }
+            item = std::move(items.front());
+            items.pop_front();
+            lock.unlock();
+            notFull.notify_one();
+            return true;
+        }
+
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closed = true;
+            }
+            notFull.notify_all();
+            notEmpty.notify_all();
+        }
+
+        QueueStats getStats() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return stats;
+        }
+
+    private:
+        mutable std::mutex mutex;
+        std::condition_variable notFull;
+        std::condition_variable notEmpty;
+        std::deque<T> items;
+        bool closed{false};
+        QueueStats stats;
+    };
+}
+
+#endif // JACY_UTILS_THREAD_H
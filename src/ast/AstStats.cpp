@@ -0,0 +1,614 @@
+#include "ast/AstStats.h"
+
+namespace jc::ast {
+    AstStats::AstStats() : StubVisitor("AstStats") {
+        log.getConfig().printOwner = false;
+    }
+
+    void AstStats::addTokens(const parser::token_list & fileTokens) {
+        tokens.count += fileTokens.size();
+        tokens.bytes += tokensBytes(fileTokens);
+    }
+
+    void AstStats::collect(const sess::sess_ptr & sess, const Party & party) {
+        kinds.clear();
+        files.clear();
+        childrenStack.clear();
+        currentFile = nullptr;
+
+        party.getRootModule()->accept(*this);
+
+        // `std::map` node: three pointers and color (padded to pointer) followed by the value
+        constexpr size_t mapNodeOverhead = 4 * sizeof(void*);
+
+        nodeMap.count = sess->nodeMap.size();
+        nodeMap.bytes = nodeMap.count * (mapNodeOverhead + sizeof(std::pair<const node_id, node_ptr>));
+
+        sourceMap = {};
+        for (const auto & file : sess->sourceMap.getSources()) {
+            // Dense file table entry and path -> id hash map node
+            sourceMap.count++;
+            sourceMap.bytes += sizeof(file) + 2 * sizeof(void*) + sizeof(std::pair<const std::string, span::file_id_t>);
+            sourceMap.bytes += strBytes(file.path.string()) + vecBytes(file.lines);
+            // Note: Mapped contents are not heap memory
+            if (file.owned) {
+                sourceMap.bytes += strBytes(*file.owned);
+            }
+        }
+    }
+
+    void AstStats::print() {
+        size_t totalCount = 0;
+        size_t totalBytes = 0;
+        for (const auto & kind : kinds) {
+            log.raw(
+                utils::str::padEnd(kind.first, 20, ' '),
+                "count:", kind.second.count,
+                "| size:", kind.second.bytes / kind.second.count,
+                "| bytes:", kind.second.bytes,
+                "| max depth:", kind.second.maxDepth
+            ).nl();
+            totalCount += kind.second.count;
+            totalBytes += kind.second.bytes;
+        }
+        common::Logger::nl();
+
+        for (const auto & file : files) {
+            log.raw(
+                utils::str::padEnd(file.name, 20, ' '),
+                "nodes:", file.nodes,
+                "| bytes:", file.bytes,
+                "| max depth:", file.maxDepth,
+                "| avg fan-out:", file.avgFanOut()
+            ).nl();
+        }
+        common::Logger::nl();
+
+        log.raw("Nodes:", totalCount, "| bytes:", totalBytes);
+        if (totalCount > 0) {
+            log.raw(" | bytes per node:", totalBytes / totalCount);
+        }
+        log.nl();
+        log.raw("Tokens:", tokens.count, "| bytes:", tokens.bytes).nl();
+        log.raw("NodeMap:", nodeMap.count, "entries | bytes:", nodeMap.bytes).nl();
+        log.raw("SourceMap:", sourceMap.count, "files | bytes:", sourceMap.bytes).nl();
+        log.raw("sizeof(Span):", sizeof(Span), "| sizeof(Token):", sizeof(parser::Token)).nl();
+        log.raw("Symbols:", span::Interner::getInstance().size()).nl();
+        log.raw("Interned spans:", span::SpanInterner::getInstance().size()).nl();
+    }
+
+    void AstStats::printJson() {
+        const auto jsonStr = [](const std::string & str) {
+            std::string escaped = "\"";
+            for (const auto & c : str) {
+                if (c == '"' or c == '\\') {
+                    escaped += '\\';
+                }
+                escaped += c;
+            }
+            return escaped + "\"";
+        };
+
+        std::stringstream json;
+        size_t totalCount = 0;
+        size_t totalBytes = 0;
+
+        json << "{\"kinds\":{";
+        for (auto it = kinds.begin(); it != kinds.end(); it++) {
+            if (it != kinds.begin()) {
+                json << ",";
+            }
+            json << jsonStr(it->first) << ":{"
+                 << "\"count\":" << it->second.count << ","
+                 << "\"bytes\":" << it->second.bytes << ","
+                 << "\"maxDepth\":" << it->second.maxDepth << "}";
+            totalCount += it->second.count;
+            totalBytes += it->second.bytes;
+        }
+
+        json << "},\"files\":[";
+        for (size_t i = 0; i < files.size(); i++) {
+            const auto & file = files.at(i);
+            if (i > 0) {
+                json << ",";
+            }
+            json << "{\"name\":" << jsonStr(file.name) << ","
+                 << "\"nodes\":" << file.nodes << ","
+                 << "\"bytes\":" << file.bytes << ","
+                 << "\"maxDepth\":" << file.maxDepth << ","
+                 << "\"avgFanOut\":" << file.avgFanOut() << "}";
+        }
+
+        json << "],\"totals\":{"
+             << "\"nodes\":{\"count\":" << totalCount << ",\"bytes\":" << totalBytes << "},"
+             << "\"tokens\":{\"count\":" << tokens.count << ",\"bytes\":" << tokens.bytes << "},"
+             << "\"nodeMap\":{\"count\":" << nodeMap.count << ",\"bytes\":" << nodeMap.bytes << "},"
+             << "\"sourceMap\":{\"count\":" << sourceMap.count << ",\"bytes\":" << sourceMap.bytes << "},"
+             << "\"symbols\":" << span::Interner::getInstance().size() << ","
+             << "\"internedSpans\":" << span::SpanInterner::getInstance().size()
+             << "}}";
+
+        log.raw(json.str()).nl();
+    }
+
+    void AstStats::exit() {
+        const auto children = childrenStack.back();
+        childrenStack.pop_back();
+        if (currentFile and children > 0) {
+            currentFile->parents++;
+            currentFile->edges += children;
+        }
+    }
+
+    // Heap size helpers //
+    size_t AstStats::strBytes(const std::string & str) {
+        // Strings within SSO capacity do not allocate
+        static const auto ssoCapacity = std::string().capacity();
+        return str.capacity() > ssoCapacity ? str.capacity() + 1 : 0;
+    }
+
+    size_t AstStats::tokenBytes(const parser::Token & token) {
+        return strBytes(token.val);
+    }
+
+    size_t AstStats::tokensBytes(const parser::token_list & tokens) {
+        size_t bytes = vecBytes(tokens);
+        for (const auto & token : tokens) {
+            bytes += tokenBytes(token);
+        }
+        return bytes;
+    }
+
+    size_t AstStats::typeParamsBytes(const opt_type_params & typeParams) {
+        if (typeParams.none()) {
+            return 0;
+        }
+        return vecBytes(typeParams.unwrap());
+    }
+
+    size_t AstStats::enumEntryBytes(const EnumEntry & enumEntry) {
+        if (const auto * named = std::get_if<named_list>(&enumEntry.body)) {
+            return vecBytes(*named);
+        }
+        if (const auto * fields = std::get_if<struct_field_list>(&enumEntry.body)) {
+            return vecBytes(*fields);
+        }
+        return 0;
+    }
+
+    void AstStats::visit(const ErrorNode & errorNode) {
+        enter(errorNode, "ErrorNode");
+        exit();
+    }
+
+    void AstStats::visit(const FileModule & fileModule) {
+        files.emplace_back();
+        currentFile = &files.back();
+        currentFile->name = fileModule.getName();
+        StubVisitor::visit(fileModule);
+        currentFile = nullptr;
+    }
+
+    void AstStats::visit(const File & file) {
+        enter(file, "File", vecBytes(file.items));
+        StubVisitor::visit(file);
+        exit();
+    }
+
+    // Items //
+    void AstStats::visit(const Enum & enumDecl) {
+        enter(enumDecl, "Enum", vecBytes(enumDecl.entries) + vecBytes(enumDecl.attributes));
+        StubVisitor::visit(enumDecl);
+        exit();
+    }
+
+    void AstStats::visit(const EnumEntry & enumEntry) {
+        enter(enumEntry, "EnumEntry", enumEntryBytes(enumEntry));
+        StubVisitor::visit(enumEntry);
+        exit();
+    }
+
+    void AstStats::visit(const Func & func) {
+        enter(func, "Func",
+            tokensBytes(func.modifiers) + typeParamsBytes(func.typeParams) + vecBytes(func.params)
+                + vecBytes(func.attributes)
+        );
+        StubVisitor::visit(func);
+        exit();
+    }
+
+    void AstStats::visit(const FuncParam & funcParam) {
+        enter(funcParam, "FuncParam");
+        StubVisitor::visit(funcParam);
+        exit();
+    }
+
+    void AstStats::visit(const Impl & impl) {
+        enter(impl, "Impl", typeParamsBytes(impl.typeParams) + vecBytes(impl.members) + vecBytes(impl.attributes));
+        StubVisitor::visit(impl);
+        exit();
+    }
+
+    void AstStats::visit(const Mod & mod) {
+        enter(mod, "Mod", vecBytes(mod.items) + vecBytes(mod.attributes));
+        StubVisitor::visit(mod);
+        exit();
+    }
+
+    void AstStats::visit(const Struct & _struct) {
+        enter(_struct, "Struct",
+            typeParamsBytes(_struct.typeParams) + vecBytes(_struct.fields)
+                + vecBytes(_struct.attributes)
+        );
+        StubVisitor::visit(_struct);
+        exit();
+    }
+
+    void AstStats::visit(const StructField & field) {
+        enter(field, "StructField");
+        StubVisitor::visit(field);
+        exit();
+    }
+
+    void AstStats::visit(const Trait & trait) {
+        enter(trait, "Trait",
+            typeParamsBytes(trait.typeParams) + vecBytes(trait.superTraits) + vecBytes(trait.members)
+                + vecBytes(trait.attributes)
+        );
+        StubVisitor::visit(trait);
+        exit();
+    }
+
+    void AstStats::visit(const TypeAlias & typeAlias) {
+        enter(typeAlias, "TypeAlias", vecBytes(typeAlias.attributes));
+        StubVisitor::visit(typeAlias);
+        exit();
+    }
+
+    void AstStats::visit(const UseDecl & useDecl) {
+        enter(useDecl, "UseDecl", vecBytes(useDecl.attributes));
+        StubVisitor::visit(useDecl);
+        exit();
+    }
+
+    void AstStats::visit(const UseTreeRaw & useTree) {
+        enter(useTree, "UseTreeRaw");
+        StubVisitor::visit(useTree);
+        exit();
+    }
+
+    void AstStats::visit(const UseTreeSpecific & useTree) {
+        enter(useTree, "UseTreeSpecific", vecBytes(useTree.specifics));
+        StubVisitor::visit(useTree);
+        exit();
+    }
+
+    void AstStats::visit(const UseTreeRebind & useTree) {
+        enter(useTree, "UseTreeRebind");
+        StubVisitor::visit(useTree);
+        exit();
+    }
+
+    void AstStats::visit(const UseTreeAll & useTree) {
+        enter(useTree, "UseTreeAll");
+        StubVisitor::visit(useTree);
+        exit();
+    }
+
+    // Statements //
+    void AstStats::visit(const ExprStmt & exprStmt) {
+        enter(exprStmt, "ExprStmt");
+        StubVisitor::visit(exprStmt);
+        exit();
+    }
+
+    void AstStats::visit(const ForStmt & forStmt) {
+        enter(forStmt, "ForStmt");
+        StubVisitor::visit(forStmt);
+        exit();
+    }
+
+    void AstStats::visit(const ItemStmt & itemStmt) {
+        enter(itemStmt, "ItemStmt");
+        StubVisitor::visit(itemStmt);
+        exit();
+    }
+
+    void AstStats::visit(const VarStmt & varStmt) {
+        enter(varStmt, "VarStmt", tokenBytes(varStmt.kind));
+        StubVisitor::visit(varStmt);
+        exit();
+    }
+
+    void AstStats::visit(const WhileStmt & whileStmt) {
+        enter(whileStmt, "WhileStmt");
+        StubVisitor::visit(whileStmt);
+        exit();
+    }
+
+    // Expressions //
+    void AstStats::visit(const Assignment & assign) {
+        enter(assign, "Assignment", tokenBytes(assign.op));
+        StubVisitor::visit(assign);
+        exit();
+    }
+
+    void AstStats::visit(const Block & block) {
+        enter(block, "Block", vecBytes(block.stmts));
+        StubVisitor::visit(block);
+        exit();
+    }
+
+    void AstStats::visit(const BorrowExpr & borrowExpr) {
+        enter(borrowExpr, "BorrowExpr");
+        StubVisitor::visit(borrowExpr);
+        exit();
+    }
+
+    void AstStats::visit(const BreakExpr & breakExpr) {
+        enter(breakExpr, "BreakExpr");
+        StubVisitor::visit(breakExpr);
+        exit();
+    }
+
+    void AstStats::visit(const ContinueExpr & continueExpr) {
+        enter(continueExpr, "ContinueExpr");
+        StubVisitor::visit(continueExpr);
+        exit();
+    }
+
+    void AstStats::visit(const DerefExpr & derefExpr) {
+        enter(derefExpr, "DerefExpr");
+        StubVisitor::visit(derefExpr);
+        exit();
+    }
+
+    void AstStats::visit(const IfExpr & ifExpr) {
+        enter(ifExpr, "IfExpr");
+        StubVisitor::visit(ifExpr);
+        exit();
+    }
+
+    void AstStats::visit(const Infix & infix) {
+        enter(infix, "Infix", tokenBytes(infix.op));
+        StubVisitor::visit(infix);
+        exit();
+    }
+
+    void AstStats::visit(const Invoke & invoke) {
+        enter(invoke, "Invoke", vecBytes(invoke.args));
+        StubVisitor::visit(invoke);
+        exit();
+    }
+
+    void AstStats::visit(const Lambda & lambdaExpr) {
+        enter(lambdaExpr, "Lambda", vecBytes(lambdaExpr.params));
+        StubVisitor::visit(lambdaExpr);
+        exit();
+    }
+
+    void AstStats::visit(const LambdaParam & param) {
+        enter(param, "LambdaParam");
+        StubVisitor::visit(param);
+        exit();
+    }
+
+    void AstStats::visit(const ListExpr & listExpr) {
+        enter(listExpr, "ListExpr", vecBytes(listExpr.elements));
+        StubVisitor::visit(listExpr);
+        exit();
+    }
+
+    void AstStats::visit(const LiteralConstant & literalConstant) {
+        enter(literalConstant, "LiteralConstant", tokenBytes(literalConstant.token));
+        StubVisitor::visit(literalConstant);
+        exit();
+    }
+
+    void AstStats::visit(const LoopExpr & loopExpr) {
+        enter(loopExpr, "LoopExpr");
+        StubVisitor::visit(loopExpr);
+        exit();
+    }
+
+    void AstStats::visit(const MemberAccess & memberAccess) {
+        enter(memberAccess, "MemberAccess");
+        StubVisitor::visit(memberAccess);
+        exit();
+    }
+
+    void AstStats::visit(const ParenExpr & parenExpr) {
+        enter(parenExpr, "ParenExpr");
+        StubVisitor::visit(parenExpr);
+        exit();
+    }
+
+    void AstStats::visit(const PathExpr & pathExpr) {
+        enter(pathExpr, "PathExpr", vecBytes(pathExpr.segments));
+        StubVisitor::visit(pathExpr);
+        exit();
+    }
+
+    void AstStats::visit(const PathExprSeg & seg) {
+        enter(seg, "PathExprSeg", typeParamsBytes(seg.typeParams));
+        StubVisitor::visit(seg);
+        exit();
+    }
+
+    void AstStats::visit(const Prefix & prefix) {
+        enter(prefix, "Prefix", tokenBytes(prefix.op));
+        StubVisitor::visit(prefix);
+        exit();
+    }
+
+    void AstStats::visit(const QuestExpr & questExpr) {
+        enter(questExpr, "QuestExpr");
+        StubVisitor::visit(questExpr);
+        exit();
+    }
+
+    void AstStats::visit(const ReturnExpr & returnExpr) {
+        enter(returnExpr, "ReturnExpr");
+        StubVisitor::visit(returnExpr);
+        exit();
+    }
+
+    void AstStats::visit(const SpreadExpr & spreadExpr) {
+        enter(spreadExpr, "SpreadExpr", tokenBytes(spreadExpr.token));
+        StubVisitor::visit(spreadExpr);
+        exit();
+    }
+
+    void AstStats::visit(const StructExpr & structExpr) {
+        enter(structExpr, "StructExpr", vecBytes(structExpr.fields));
+        StubVisitor::visit(structExpr);
+        exit();
+    }
+
+    void AstStats::visit(const StructExprField & field) {
+        enter(field, "StructExprField");
+        StubVisitor::visit(field);
+        exit();
+    }
+
+    void AstStats::visit(const Subscript & subscript) {
+        enter(subscript, "Subscript", vecBytes(subscript.indices));
+        StubVisitor::visit(subscript);
+        exit();
+    }
+
+    void AstStats::visit(const ThisExpr & thisExpr) {
+        enter(thisExpr, "ThisExpr");
+        StubVisitor::visit(thisExpr);
+        exit();
+    }
+
+    void AstStats::visit(const TupleExpr & tupleExpr) {
+        enter(tupleExpr, "TupleExpr", vecBytes(tupleExpr.elements));
+        StubVisitor::visit(tupleExpr);
+        exit();
+    }
+
+    void AstStats::visit(const UnitExpr & unitExpr) {
+        enter(unitExpr, "UnitExpr");
+        StubVisitor::visit(unitExpr);
+        exit();
+    }
+
+    void AstStats::visit(const WhenExpr & whenExpr) {
+        enter(whenExpr, "WhenExpr", vecBytes(whenExpr.entries));
+        StubVisitor::visit(whenExpr);
+        exit();
+    }
+
+    void AstStats::visit(const WhenEntry & entry) {
+        enter(entry, "WhenEntry", vecBytes(entry.conditions));
+        StubVisitor::visit(entry);
+        exit();
+    }
+
+    // Types //
+    void AstStats::visit(const ParenType & parenType) {
+        enter(parenType, "ParenType");
+        StubVisitor::visit(parenType);
+        exit();
+    }
+
+    void AstStats::visit(const TupleType & tupleType) {
+        enter(tupleType, "TupleType", vecBytes(tupleType.elements));
+        StubVisitor::visit(tupleType);
+        exit();
+    }
+
+    void AstStats::visit(const TupleTypeEl & el) {
+        enter(el, "TupleTypeEl");
+        StubVisitor::visit(el);
+        exit();
+    }
+
+    void AstStats::visit(const FuncType & funcType) {
+        enter(funcType, "FuncType", vecBytes(funcType.params));
+        StubVisitor::visit(funcType);
+        exit();
+    }
+
+    void AstStats::visit(const SliceType & listType) {
+        enter(listType, "SliceType");
+        StubVisitor::visit(listType);
+        exit();
+    }
+
+    void AstStats::visit(const ArrayType & arrayType) {
+        enter(arrayType, "ArrayType");
+        StubVisitor::visit(arrayType);
+        exit();
+    }
+
+    void AstStats::visit(const TypePath & typePath) {
+        enter(typePath, "TypePath", vecBytes(typePath.segments));
+        StubVisitor::visit(typePath);
+        exit();
+    }
+
+    void AstStats::visit(const TypePathSeg & seg) {
+        enter(seg, "TypePathSeg", typeParamsBytes(seg.typeParams));
+        StubVisitor::visit(seg);
+        exit();
+    }
+
+    void AstStats::visit(const UnitType & unitType) {
+        enter(unitType, "UnitType");
+        StubVisitor::visit(unitType);
+        exit();
+    }
+
+    // Type params //
+    void AstStats::visit(const GenericType & genericType) {
+        enter(genericType, "GenericType");
+        StubVisitor::visit(genericType);
+        exit();
+    }
+
+    void AstStats::visit(const Lifetime & lifetime) {
+        enter(lifetime, "Lifetime");
+        StubVisitor::visit(lifetime);
+        exit();
+    }
+
+    void AstStats::visit(const ConstParam & constParam) {
+        enter(constParam, "ConstParam");
+        StubVisitor::visit(constParam);
+        exit();
+    }
+
+    // Fragments //
+    void AstStats::visit(const Attribute & attr) {
+        enter(attr, "Attribute", vecBytes(attr.params));
+        StubVisitor::visit(attr);
+        exit();
+    }
+
+    void AstStats::visit(const Identifier & id) {
+        enter(id, "Identifier");
+        StubVisitor::visit(id);
+        exit();
+    }
+
+    void AstStats::visit(const NamedElement & el) {
+        enter(el, "NamedElement");
+        StubVisitor::visit(el);
+        exit();
+    }
+
+    void AstStats::visit(const SimplePath & path) {
+        enter(path, "SimplePath", vecBytes(path.segments));
+        StubVisitor::visit(path);
+        exit();
+    }
+
+    void AstStats::visit(const SimplePathSeg & seg) {
+        enter(seg, "SimplePathSeg");
+        StubVisitor::visit(seg);
+        exit();
+    }
+}
@@ -3,12 +3,24 @@
 namespace jc::ast {
     Linter::Linter() = default;
 
-    dt::SuggResult<dt::none_t> Linter::lint(const Party & party) {
+    dt::SuggResult<dt::none_t> Linter::lint(const sess::sess_ptr & sess, const Party & party) {
+        this->sess = sess;
+        funcBodies.clear();
+
         party.getRootModule()->accept(*this);
 
         return {dt::None, extractSuggestions()};
     }
 
+    dt::SuggResult<dt::none_t> Linter::lintFile(const sess::sess_ptr & sess, const FileModule & fileModule) {
+        this->sess = sess;
+        funcBodies.clear();
+
+        fileModule.accept(*this);
+
+        return {dt::None, extractSuggestions()};
+    }
+
     void Linter::visit(const ErrorNode&) {
         common::Logger::devPanic("Unexpected [ERROR] node on Linter stage");
     }
@@ -117,8 +129,10 @@ namespace jc::ast {
         pushContext(LinterContext::Func);
         if (func.body) {
             func.body.unwrap()->accept(*this);
+            lintDuplicateBody(func, func.body.unwrap()->id);
         } else if (func.oneLineBody) {
             func.oneLineBody.unwrap().accept(*this);
+            lintDuplicateBody(func, func.oneLineBody.unwrap().unwrap()->id);
         } else {
             Logger::devPanic("Linter: Func hasn't either one-line either raw body");
         }
@@ -228,7 +242,9 @@ namespace jc::ast {
     void Linter::visit(const VarStmt & varStmt) {
         varStmt.name.accept(*this);
 
-        varStmt.type->accept(*this);
+        if (varStmt.type) {
+            varStmt.type.unwrap().accept(*this);
+        }
 
         if (varStmt.assignExpr) {
             varStmt.assignExpr.unwrap().accept(*this);
@@ -302,13 +318,13 @@ namespace jc::ast {
             breakExpr.expr.unwrap().accept(*this);
         }
 
-        if (not isDeepInside(LinterContext::Loop)) {
+        if (not isInsideLoop(breakExpr.id)) {
             suggestErrorMsg("`break` outside of loop", breakExpr.span);
         }
     }
 
     void Linter::visit(const ContinueExpr & continueExpr) {
-        if (not isDeepInside(LinterContext::Loop)) {
+        if (not isInsideLoop(continueExpr.id)) {
             suggestErrorMsg("`continue` outside of loop", continueExpr.span);
         }
     }
@@ -483,7 +499,7 @@ namespace jc::ast {
             returnExpr.expr.unwrap().accept(*this);
         }
 
-        if (not isDeepInside(LinterContext::Func)) {
+        if (sess->parentIndex.getEnclosingFunc(returnExpr.id).none()) {
             suggestErrorMsg("`return` outside of function", returnExpr.span);
         }
     }
@@ -678,13 +694,15 @@ namespace jc::ast {
         return ctxStack.back() == ctx;
     }
 
-    bool Linter::isDeepInside(LinterContext ctx) {
-        for (auto rit = ctxStack.rbegin(); rit != ctxStack.rend(); rit++) {
-            if (*rit == ctx) {
-                return true;
-            }
+    bool Linter::isInsideLoop(node_id nodeId) {
+        // Loop must not be outside of the nearest function, e.g. `break` in lambda does not break outer loop
+        const auto & index = sess->parentIndex;
+        const auto & loop = index.getEnclosingLoop(nodeId);
+        if (loop.none()) {
+            return false;
         }
-        return false;
+        const auto & func = index.getEnclosingFunc(nodeId);
+        return func.none() or index.isInside(loop.unwrap(), func.unwrap());
     }
 
     void Linter::pushContext(LinterContext ctx) {
@@ -694,4 +712,24 @@ namespace jc::ast {
     void Linter::popContext() {
         ctxStack.pop_back();
     }
+
+    // Duplicates //
+    void Linter::lintDuplicateBody(const Func & func, node_id bodyId) {
+        const auto & bodyHash = sess->nodeMap.getStructHash(bodyId);
+        if (bodyHash.size < MIN_DUPLICATE_SIZE) {
+            return;
+        }
+
+        const auto & original = funcBodies.find(bodyHash.hash);
+        if (original == funcBodies.end()) {
+            funcBodies.emplace(bodyHash.hash, func.name);
+            return;
+        }
+
+        suggestWarnMsg(
+            "Function `" + func.name.unwrap()->getValue() + "` has the same body as function `"
+                + original->second.unwrap()->getValue() + "`",
+            func.name.span()
+        );
+    }
 }
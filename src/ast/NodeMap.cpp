@@ -12,4 +12,27 @@ namespace jc::ast {
     node_ptr NodeMap::getNodePtr(node_id nodeId) const {
         return nodes.at(nodeId);
     }
+
+    size_t NodeMap::size() const {
+        return nodes.size();
+    }
+
+    void NodeMap::eraseNodes(node_id begin, node_id end) {
+        nodes.erase(nodes.lower_bound(begin), nodes.lower_bound(end));
+        for (node_id nodeId = begin; nodeId < end; nodeId++) {
+            structHashes.erase(nodeId);
+        }
+    }
+
+    void NodeMap::setStructHash(node_id nodeId, const StructHash & hash) {
+        structHashes[nodeId] = hash;
+    }
+
+    const StructHash & NodeMap::getStructHash(node_id nodeId) const {
+        const auto & found = structHashes.find(nodeId);
+        if (found == structHashes.end()) {
+            common::Logger::devPanic("No structural hash found for node", nodeId, "in `NodeMap::getStructHash`");
+        }
+        return found->second;
+    }
 }
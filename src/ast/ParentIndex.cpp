@@ -0,0 +1,64 @@
+#include "ast/ParentIndex.h"
+
+namespace jc::ast {
+    void ParentIndex::reset(size_t nodesCount) {
+        entries.assign(nodesCount, Entry{});
+    }
+
+    void ParentIndex::grow(size_t nodesCount) {
+        if (entries.size() < nodesCount) {
+            entries.resize(nodesCount);
+        }
+    }
+
+    void ParentIndex::setEntry(node_id nodeId, const Entry & entry) {
+        if (nodeId >= entries.size()) {
+            common::Logger::devPanic("Node id", nodeId, "is out of `ParentIndex` bounds in `ParentIndex::setEntry`");
+        }
+        entries[nodeId] = entry;
+    }
+
+    void ParentIndex::setSubtreeEnd(node_id nodeId, uint32_t subtreeEnd) {
+        entries.at(nodeId).subtreeEnd = subtreeEnd;
+    }
+
+    const ParentIndex::Entry & ParentIndex::getEntry(node_id nodeId) const {
+        if (nodeId >= entries.size()) {
+            common::Logger::devPanic("Node id", nodeId, "is out of `ParentIndex` bounds in `ParentIndex::getEntry`");
+        }
+        return entries[nodeId];
+    }
+
+    opt_node_id ParentIndex::getParent(node_id nodeId) const {
+        return optId(getEntry(nodeId).parent);
+    }
+
+    uint32_t ParentIndex::getPreorder(node_id nodeId) const {
+        return getEntry(nodeId).preorder;
+    }
+
+    uint32_t ParentIndex::getSubtreeEnd(node_id nodeId) const {
+        return getEntry(nodeId).subtreeEnd;
+    }
+
+    bool ParentIndex::isInside(node_id nodeId, node_id ancestorId) const {
+        const auto & node = getEntry(nodeId);
+        const auto & ancestor = getEntry(ancestorId);
+        return ancestor.preorder < node.preorder and node.preorder < ancestor.subtreeEnd;
+    }
+
+    opt_node_id ParentIndex::getEnclosingFunc(node_id nodeId) const {
+        return optId(getEntry(nodeId).enclosingFunc);
+    }
+
+    opt_node_id ParentIndex::getEnclosingLoop(node_id nodeId) const {
+        return optId(getEntry(nodeId).enclosingLoop);
+    }
+
+    opt_node_id ParentIndex::optId(node_id nodeId) {
+        if (nodeId == NONE_NODE_ID) {
+            return dt::None;
+        }
+        return nodeId;
+    }
+}
@@ -0,0 +1,66 @@
+#include "ast/ParentIndexBuilder.h"
+
+namespace jc::ast {
+    ParentIndexBuilder::ParentIndexBuilder() : StubVisitor("ParentIndexBuilder") {}
+
+    void ParentIndexBuilder::build(const sess::sess_ptr & sess, const Party & party) {
+        this->sess = sess;
+        sess->parentIndex.reset(sess->nodeMap.idsCount());
+        party.getRootModule()->accept(*this);
+    }
+
+    void ParentIndexBuilder::buildFile(const sess::sess_ptr & sess, const FileModule & fileModule) {
+        this->sess = sess;
+        sess->parentIndex.grow(sess->nodeMap.idsCount());
+        fileModule.accept(*this);
+    }
+
+    void ParentIndexBuilder::visit(const FileModule & fileModule) {
+        frames.clear();
+        preorder = fileModule.getFirstNodeId();
+        enclosingFunc = NONE_NODE_ID;
+        enclosingLoop = NONE_NODE_ID;
+
+        walker.walk(
+            *fileModule.getFile(),
+            [&](const Node & node, size_t) {
+                enter(node);
+            },
+            [&](const Node&, size_t) {
+                exit();
+            }
+        );
+    }
+
+    void ParentIndexBuilder::enter(const Node & node) {
+        ParentIndex::Entry entry;
+        entry.parent = frames.empty() ? NONE_NODE_ID : frames.back().nodeId;
+        entry.enclosingFunc = enclosingFunc;
+        entry.enclosingLoop = enclosingLoop;
+        entry.preorder = preorder++;
+        sess->parentIndex.setEntry(node.id, entry);
+
+        frames.push_back({node.id, enclosingFunc, enclosingLoop});
+
+        // Node itself is not enclosed by itself, so it becomes the nearest one only for its subtree
+        switch (walker.getRole()) {
+            case NodeRole::FuncLike: {
+                enclosingFunc = node.id;
+                break;
+            }
+            case NodeRole::LoopLike: {
+                enclosingLoop = node.id;
+                break;
+            }
+            case NodeRole::Other: break;
+        }
+    }
+
+    void ParentIndexBuilder::exit() {
+        const auto & frame = frames.back();
+        sess->parentIndex.setSubtreeEnd(frame.nodeId, preorder);
+        enclosingFunc = frame.enclosingFunc;
+        enclosingLoop = frame.enclosingLoop;
+        frames.pop_back();
+    }
+}
@@ -0,0 +1,360 @@
+#include "ast/StructHasher.h"
+
+namespace jc::ast {
+    StructHasher::StructHasher() : StubVisitor("StructHasher") {}
+
+    void StructHasher::hash(const sess::sess_ptr & sess, const Party & party) {
+        this->sess = sess;
+        frames.clear();
+        party.getRootModule()->accept(*this);
+    }
+
+    void StructHasher::hashFile(const sess::sess_ptr & sess, const FileModule & fileModule) {
+        this->sess = sess;
+        frames.clear();
+        fileModule.accept(*this);
+    }
+
+    void StructHasher::visit(const FileModule & fileModule) {
+        walker.walk(
+            *fileModule.getFile(),
+            [&](const Node & node, size_t) {
+                enter(node);
+            },
+            [&](const Node & node, size_t) {
+                exit(node);
+            }
+        );
+    }
+
+    void StructHasher::enter(const Node & node) {
+        // Node kind and its own data are added by `visit`, children hashes are added on their `exit`
+        frames.emplace_back();
+        node.accept(*this);
+    }
+
+    void StructHasher::exit(const Node & node) {
+        auto & frame = frames.back();
+        frame.hasher.add(static_cast<uint64_t>(frame.children));
+        const StructHash hash{frame.hasher.digest(), frame.size};
+        sess->nodeMap.setStructHash(node.id, hash);
+        frames.pop_back();
+
+        if (not frames.empty()) {
+            auto & parent = frames.back();
+            parent.hasher.add(hash.hash);
+            parent.children++;
+            parent.size += hash.size;
+        }
+    }
+
+    void StructHasher::add(const std::string & str) {
+        frames.back().hasher.add(str);
+    }
+
+    void StructHasher::visit(const ErrorNode&) {
+        add("ErrorNode");
+    }
+
+    void StructHasher::visit(const File&) {
+        add("File");
+    }
+
+    // Items //
+    void StructHasher::visit(const Enum&) {
+        add("Enum");
+    }
+
+    void StructHasher::visit(const EnumEntry & enumEntry) {
+        add("EnumEntry");
+        add(enumEntry.kind);
+    }
+
+    void StructHasher::visit(const Func & func) {
+        add("Func");
+        for (const auto & modifier : func.modifiers) {
+            add(modifier.kind);
+        }
+        add(static_cast<bool>(func.oneLineBody));
+    }
+
+    void StructHasher::visit(const FuncParam&) {
+        add("FuncParam");
+    }
+
+    void StructHasher::visit(const Impl&) {
+        add("Impl");
+    }
+
+    void StructHasher::visit(const Mod&) {
+        add("Mod");
+    }
+
+    void StructHasher::visit(const Struct&) {
+        add("Struct");
+    }
+
+    void StructHasher::visit(const StructField&) {
+        add("StructField");
+    }
+
+    void StructHasher::visit(const Trait&) {
+        add("Trait");
+    }
+
+    void StructHasher::visit(const TypeAlias&) {
+        add("TypeAlias");
+    }
+
+    void StructHasher::visit(const UseDecl&) {
+        add("UseDecl");
+    }
+
+    void StructHasher::visit(const UseTreeRaw&) {
+        add("UseTreeRaw");
+    }
+
+    void StructHasher::visit(const UseTreeSpecific & useTree) {
+        add("UseTreeSpecific");
+        add(static_cast<bool>(useTree.path));
+    }
+
+    void StructHasher::visit(const UseTreeRebind&) {
+        add("UseTreeRebind");
+    }
+
+    void StructHasher::visit(const UseTreeAll & useTree) {
+        add("UseTreeAll");
+        add(static_cast<bool>(useTree.path));
+    }
+
+    // Statements //
+    void StructHasher::visit(const ExprStmt&) {
+        add("ExprStmt");
+    }
+
+    void StructHasher::visit(const ForStmt&) {
+        add("ForStmt");
+    }
+
+    void StructHasher::visit(const ItemStmt&) {
+        add("ItemStmt");
+    }
+
+    void StructHasher::visit(const VarStmt & varStmt) {
+        add("VarStmt");
+        add(varStmt.kind.kind);
+    }
+
+    void StructHasher::visit(const WhileStmt&) {
+        add("WhileStmt");
+    }
+
+    // Expressions //
+    void StructHasher::visit(const Assignment & assign) {
+        add("Assignment");
+        add(assign.op.kind);
+    }
+
+    void StructHasher::visit(const Block&) {
+        add("Block");
+    }
+
+    void StructHasher::visit(const BorrowExpr&) {
+        add("BorrowExpr");
+    }
+
+    void StructHasher::visit(const BreakExpr&) {
+        add("BreakExpr");
+    }
+
+    void StructHasher::visit(const ContinueExpr&) {
+        add("ContinueExpr");
+    }
+
+    void StructHasher::visit(const DerefExpr&) {
+        add("DerefExpr");
+    }
+
+    void StructHasher::visit(const IfExpr & ifExpr) {
+        add("IfExpr");
+        add(static_cast<bool>(ifExpr.ifBranch));
+        add(static_cast<bool>(ifExpr.elseBranch));
+    }
+
+    void StructHasher::visit(const Infix & infix) {
+        add("Infix");
+        add(infix.op.kind);
+    }
+
+    void StructHasher::visit(const Invoke&) {
+        add("Invoke");
+    }
+
+    void StructHasher::visit(const Lambda&) {
+        add("Lambda");
+    }
+
+    void StructHasher::visit(const LambdaParam&) {
+        add("LambdaParam");
+    }
+
+    void StructHasher::visit(const ListExpr&) {
+        add("ListExpr");
+    }
+
+    void StructHasher::visit(const LiteralConstant & literalConstant) {
+        add("LiteralConstant");
+        add(literalConstant.token.kind);
+        add(literalConstant.token.val);
+    }
+
+    void StructHasher::visit(const LoopExpr&) {
+        add("LoopExpr");
+    }
+
+    void StructHasher::visit(const MemberAccess&) {
+        add("MemberAccess");
+    }
+
+    void StructHasher::visit(const ParenExpr&) {
+        add("ParenExpr");
+    }
+
+    void StructHasher::visit(const PathExpr&) {
+        add("PathExpr");
+    }
+
+    void StructHasher::visit(const PathExprSeg & seg) {
+        add("PathExprSeg");
+        add(seg.kind);
+    }
+
+    void StructHasher::visit(const Prefix & prefix) {
+        add("Prefix");
+        add(prefix.op.kind);
+    }
+
+    void StructHasher::visit(const QuestExpr&) {
+        add("QuestExpr");
+    }
+
+    void StructHasher::visit(const ReturnExpr&) {
+        add("ReturnExpr");
+    }
+
+    void StructHasher::visit(const SpreadExpr & spreadExpr) {
+        add("SpreadExpr");
+        add(spreadExpr.token.kind);
+    }
+
+    void StructHasher::visit(const StructExpr&) {
+        add("StructExpr");
+    }
+
+    void StructHasher::visit(const StructExprField & field) {
+        add("StructExprField");
+        add(field.kind);
+    }
+
+    void StructHasher::visit(const Subscript&) {
+        add("Subscript");
+    }
+
+    void StructHasher::visit(const ThisExpr&) {
+        add("ThisExpr");
+    }
+
+    void StructHasher::visit(const TupleExpr&) {
+        add("TupleExpr");
+    }
+
+    void StructHasher::visit(const UnitExpr&) {
+        add("UnitExpr");
+    }
+
+    void StructHasher::visit(const WhenExpr&) {
+        add("WhenExpr");
+    }
+
+    void StructHasher::visit(const WhenEntry&) {
+        add("WhenEntry");
+    }
+
+    // Types //
+    void StructHasher::visit(const ParenType&) {
+        add("ParenType");
+    }
+
+    void StructHasher::visit(const TupleType&) {
+        add("TupleType");
+    }
+
+    void StructHasher::visit(const TupleTypeEl & el) {
+        add("TupleTypeEl");
+        add(static_cast<bool>(el.name));
+        add(static_cast<bool>(el.type));
+    }
+
+    void StructHasher::visit(const FuncType&) {
+        add("FuncType");
+    }
+
+    void StructHasher::visit(const SliceType&) {
+        add("SliceType");
+    }
+
+    void StructHasher::visit(const ArrayType&) {
+        add("ArrayType");
+    }
+
+    void StructHasher::visit(const TypePath&) {
+        add("TypePath");
+    }
+
+    void StructHasher::visit(const TypePathSeg&) {
+        add("TypePathSeg");
+    }
+
+    void StructHasher::visit(const UnitType&) {
+        add("UnitType");
+    }
+
+    // Type params //
+    void StructHasher::visit(const GenericType&) {
+        add("GenericType");
+    }
+
+    void StructHasher::visit(const Lifetime&) {
+        add("Lifetime");
+    }
+
+    void StructHasher::visit(const ConstParam&) {
+        add("ConstParam");
+    }
+
+    // Fragments //
+    void StructHasher::visit(const Attribute&) {
+        add("Attribute");
+    }
+
+    void StructHasher::visit(const Identifier & id) {
+        add("Identifier");
+        add(id.getValue());
+    }
+
+    void StructHasher::visit(const NamedElement & el) {
+        add("NamedElement");
+        add(static_cast<bool>(el.name));
+        add(static_cast<bool>(el.value));
+    }
+
+    void StructHasher::visit(const SimplePath&) {
+        add("SimplePath");
+    }
+
+    void StructHasher::visit(const SimplePathSeg & seg) {
+        add("SimplePathSeg");
+        add(seg.kind);
+    }
+}
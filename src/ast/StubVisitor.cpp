@@ -160,6 +160,9 @@ namespace jc::ast {
         if (varStmt.type) {
             varStmt.type.unwrap().accept(*this);
         }
+        if (varStmt.assignExpr) {
+            varStmt.assignExpr.unwrap().accept(*this);
+        }
     }
 
     void StubVisitor::visit(const WhileStmt & whileStmt) {
@@ -0,0 +1,331 @@
+#include "ast/Walker.h"
+
+namespace jc::ast {
+    ChildrenCollector::ChildrenCollector() : StubVisitor("ChildrenCollector") {}
+
+    const std::vector<const Node*> & ChildrenCollector::collect(const Node & node) {
+        children.clear();
+        expanding = true;
+        role = NodeRole::Other;
+        node.accept(*this);
+        return children;
+    }
+
+    void ChildrenCollector::visit(const ErrorNode & errorNode) {
+        // Note: `ErrorNode` has no children and must not be expanded by `StubVisitor`
+        if (expanding) {
+            expanding = false;
+        } else {
+            children.push_back(&errorNode);
+        }
+    }
+
+    void ChildrenCollector::visit(const File & file) {
+        onNode(file);
+    }
+
+    // Items //
+    void ChildrenCollector::visit(const Enum & enumDecl) {
+        onNode(enumDecl);
+    }
+
+    void ChildrenCollector::visit(const EnumEntry & enumEntry) {
+        onNode(enumEntry);
+    }
+
+    void ChildrenCollector::visit(const Func & func) {
+        onNode(func);
+    }
+
+    void ChildrenCollector::visit(const FuncParam & funcParam) {
+        onNode(funcParam);
+    }
+
+    void ChildrenCollector::visit(const Impl & impl) {
+        onNode(impl);
+    }
+
+    void ChildrenCollector::visit(const Mod & mod) {
+        onNode(mod);
+    }
+
+    void ChildrenCollector::visit(const Struct & _struct) {
+        onNode(_struct);
+    }
+
+    void ChildrenCollector::visit(const StructField & field) {
+        onNode(field);
+    }
+
+    void ChildrenCollector::visit(const Trait & trait) {
+        onNode(trait);
+    }
+
+    void ChildrenCollector::visit(const TypeAlias & typeAlias) {
+        onNode(typeAlias);
+    }
+
+    void ChildrenCollector::visit(const UseDecl & useDecl) {
+        onNode(useDecl);
+    }
+
+    void ChildrenCollector::visit(const UseTreeRaw & useTree) {
+        onNode(useTree);
+    }
+
+    void ChildrenCollector::visit(const UseTreeSpecific & useTree) {
+        onNode(useTree);
+    }
+
+    void ChildrenCollector::visit(const UseTreeRebind & useTree) {
+        onNode(useTree);
+    }
+
+    void ChildrenCollector::visit(const UseTreeAll & useTree) {
+        onNode(useTree);
+    }
+
+    // Statements //
+    void ChildrenCollector::visit(const ExprStmt & exprStmt) {
+        onNode(exprStmt);
+    }
+
+    void ChildrenCollector::visit(const ForStmt & forStmt) {
+        onNode(forStmt);
+    }
+
+    void ChildrenCollector::visit(const ItemStmt & itemStmt) {
+        onNode(itemStmt);
+    }
+
+    void ChildrenCollector::visit(const VarStmt & varStmt) {
+        onNode(varStmt);
+    }
+
+    void ChildrenCollector::visit(const WhileStmt & whileStmt) {
+        onNode(whileStmt);
+    }
+
+    // Expressions //
+    void ChildrenCollector::visit(const Assignment & assign) {
+        onNode(assign);
+    }
+
+    void ChildrenCollector::visit(const Block & block) {
+        onNode(block);
+    }
+
+    void ChildrenCollector::visit(const BorrowExpr & borrowExpr) {
+        onNode(borrowExpr);
+    }
+
+    void ChildrenCollector::visit(const BreakExpr & breakExpr) {
+        onNode(breakExpr);
+    }
+
+    void ChildrenCollector::visit(const ContinueExpr & continueExpr) {
+        onNode(continueExpr);
+    }
+
+    void ChildrenCollector::visit(const DerefExpr & derefExpr) {
+        onNode(derefExpr);
+    }
+
+    void ChildrenCollector::visit(const IfExpr & ifExpr) {
+        onNode(ifExpr);
+    }
+
+    void ChildrenCollector::visit(const Infix & infix) {
+        onNode(infix);
+    }
+
+    void ChildrenCollector::visit(const Invoke & invoke) {
+        onNode(invoke);
+    }
+
+    void ChildrenCollector::visit(const Lambda & lambdaExpr) {
+        onNode(lambdaExpr);
+    }
+
+    void ChildrenCollector::visit(const LambdaParam & param) {
+        onNode(param);
+    }
+
+    void ChildrenCollector::visit(const ListExpr & listExpr) {
+        onNode(listExpr);
+    }
+
+    void ChildrenCollector::visit(const LiteralConstant & literalConstant) {
+        onNode(literalConstant);
+    }
+
+    void ChildrenCollector::visit(const LoopExpr & loopExpr) {
+        onNode(loopExpr);
+    }
+
+    void ChildrenCollector::visit(const MemberAccess & memberAccess) {
+        onNode(memberAccess);
+    }
+
+    void ChildrenCollector::visit(const ParenExpr & parenExpr) {
+        onNode(parenExpr);
+    }
+
+    void ChildrenCollector::visit(const PathExpr & pathExpr) {
+        onNode(pathExpr);
+    }
+
+    void ChildrenCollector::visit(const PathExprSeg & seg) {
+        onNode(seg);
+    }
+
+    void ChildrenCollector::visit(const Prefix & prefix) {
+        onNode(prefix);
+    }
+
+    void ChildrenCollector::visit(const QuestExpr & questExpr) {
+        onNode(questExpr);
+    }
+
+    void ChildrenCollector::visit(const ReturnExpr & returnExpr) {
+        onNode(returnExpr);
+    }
+
+    void ChildrenCollector::visit(const SpreadExpr & spreadExpr) {
+        onNode(spreadExpr);
+    }
+
+    void ChildrenCollector::visit(const StructExpr & structExpr) {
+        onNode(structExpr);
+    }
+
+    void ChildrenCollector::visit(const StructExprField & field) {
+        onNode(field);
+    }
+
+    void ChildrenCollector::visit(const Subscript & subscript) {
+        onNode(subscript);
+    }
+
+    void ChildrenCollector::visit(const ThisExpr & thisExpr) {
+        onNode(thisExpr);
+    }
+
+    void ChildrenCollector::visit(const TupleExpr & tupleExpr) {
+        onNode(tupleExpr);
+    }
+
+    void ChildrenCollector::visit(const UnitExpr & unitExpr) {
+        onNode(unitExpr);
+    }
+
+    void ChildrenCollector::visit(const WhenExpr & whenExpr) {
+        onNode(whenExpr);
+    }
+
+    void ChildrenCollector::visit(const WhenEntry & entry) {
+        onNode(entry);
+    }
+
+    // Types //
+    void ChildrenCollector::visit(const ParenType & parenType) {
+        onNode(parenType);
+    }
+
+    void ChildrenCollector::visit(const TupleType & tupleType) {
+        onNode(tupleType);
+    }
+
+    void ChildrenCollector::visit(const TupleTypeEl & el) {
+        onNode(el);
+    }
+
+    void ChildrenCollector::visit(const FuncType & funcType) {
+        onNode(funcType);
+    }
+
+    void ChildrenCollector::visit(const SliceType & listType) {
+        onNode(listType);
+    }
+
+    void ChildrenCollector::visit(const ArrayType & arrayType) {
+        onNode(arrayType);
+    }
+
+    void ChildrenCollector::visit(const TypePath & typePath) {
+        onNode(typePath);
+    }
+
+    void ChildrenCollector::visit(const TypePathSeg & seg) {
+        onNode(seg);
+    }
+
+    void ChildrenCollector::visit(const UnitType & unitType) {
+        onNode(unitType);
+    }
+
+    // Type params //
+    void ChildrenCollector::visit(const GenericType & genericType) {
+        onNode(genericType);
+    }
+
+    void ChildrenCollector::visit(const Lifetime & lifetime) {
+        onNode(lifetime);
+    }
+
+    void ChildrenCollector::visit(const ConstParam & constParam) {
+        onNode(constParam);
+    }
+
+    // Fragments //
+    void ChildrenCollector::visit(const Attribute & attr) {
+        onNode(attr);
+    }
+
+    void ChildrenCollector::visit(const Identifier & id) {
+        onNode(id);
+    }
+
+    void ChildrenCollector::visit(const NamedElement & el) {
+        onNode(el);
+    }
+
+    void ChildrenCollector::visit(const SimplePath & path) {
+        onNode(path);
+    }
+
+    void ChildrenCollector::visit(const SimplePathSeg & seg) {
+        onNode(seg);
+    }
+
+    // Walker //
+    void Walker::walk(const Node & root, const walk_cb & enter, const walk_cb & exit) {
+        stack.clear();
+        stack.push_back({&root, 0, false});
+
+        while (not stack.empty()) {
+            auto & top = stack.back();
+            const auto node = top.node;
+            const auto depth = top.depth;
+
+            if (top.expanded) {
+                stack.pop_back();
+                if (exit) {
+                    exit(*node, depth);
+                }
+                continue;
+            }
+
+            top.expanded = true;
+
+            // Children are collected before `enter`, so role of node is known to it
+            const auto & children = collector.collect(*node);
+            enter(*node, depth);
+
+            // Children are pushed in reversed order to be popped in visiting order
+            for (auto it = children.rbegin(); it != children.rend(); it++) {
+                stack.push_back({*it, depth + 1, false});
+            }
+        }
+    }
+}
@@ -10,15 +10,34 @@ namespace jc::cli {
 
     const str_vec Args::allowedBoolArgs = {
         "dev",
+        "cache",
+        "watch",
+        "in-memory",
     };
 
     const std::map<std::string, key_value_arg> Args::allowedKeyValueArgs = {
-        {"print", {dt::None, {"dir-tree", "tokens", "ast", "sugg", "source", "names", "all"}}},
+        {"print", {dt::None, {"dir-tree", "tokens", "ast", "sugg", "source", "names", "ast-stats", "ast-stats-json", "all"}}},
         {"compile-depth", {1, {"parser", "name-resolution"}}},
         {"benchmark", {1, {"each-stage", "final"}}},
+        {"max-nesting", {1, {}}},
+        {"jobs", {1, {}}},
+        {"extern", {dt::None, {}}},
+        {"emit-meta", {1, {}}},
+        {"cache-size", {1, {}}},
+        {"io", {1, {"auto", "uring", "threads"}}},
+        {"include", {dt::None, {}}},
+        {"exclude", {dt::None, {}}},
     };
 
-    const str_vec Args::anyParamKeyValueArgs = {};
+    const str_vec Args::anyParamKeyValueArgs = {
+        "max-nesting",
+        "jobs",
+        "extern",
+        "emit-meta",
+        "cache-size",
+        "include",
+        "exclude",
+    };
 
     const std::map<std::string, std::string> Args::aliases = {};
 
@@ -32,11 +32,12 @@ namespace jc::cli {
                 }
                 argIndex += 2; // Skip argument and `=`
                 str_vec params;
-                for (size_t paramIndex = argIndex; paramIndex < args.size(); paramIndex++) {
+                // Parameters are separated by `,`, which is skipped
+                for (size_t paramIndex = argIndex; paramIndex < args.size(); paramIndex += 2) {
                     const auto & param = args.at(paramIndex);
                     params.emplace_back(param);
                     argIndex = paramIndex;
-                    if (paramIndex < args.size() - 1 and args.at(paramIndex + 1) != ",") {
+                    if (paramIndex + 1 >= args.size() or args.at(paramIndex + 1) != ",") {
                         break;
                     }
                 }
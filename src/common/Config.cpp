@@ -1,6 +1,7 @@
 #include "common/Config.h"
 
 #include <iostream>
+#include <thread>
 
 namespace jc::common {
     Config::Config() = default;
@@ -26,6 +27,10 @@ namespace jc::common {
                     print.insert(PrintKind::Source);
                 } else if (val == "names") {
                     print.insert(PrintKind::Names);
+                } else if (val == "ast-stats") {
+                    print.insert(PrintKind::AstStats);
+                } else if (val == "ast-stats-json") {
+                    print.insert(PrintKind::AstStatsJson);
                 } else if (val == "all") {
                     print.insert(PrintKind::All);
                 } else {
@@ -60,8 +65,78 @@ namespace jc::common {
             }
         }
 
+        // `max-nesting`
+        const auto & maybeMaxNesting = cliConfig.getSingleValue("max-nesting");
+        if (maybeMaxNesting) {
+            const auto & mn = maybeMaxNesting.unwrap();
+            if (mn.empty() or mn.find_first_not_of("0123456789") != std::string::npos) {
+                throw std::logic_error("Invalid value for `max-nesting` cli argument, expected a number");
+            }
+            maxNesting = static_cast<uint32_t>(std::stoul(mn));
+        }
+
+        // `jobs`
+        const auto & maybeJobs = cliConfig.getSingleValue("jobs");
+        if (maybeJobs) {
+            const auto & j = maybeJobs.unwrap();
+            if (j.empty() or j.find_first_not_of("0123456789") != std::string::npos) {
+                throw std::logic_error("Invalid value for `jobs` cli argument, expected a number");
+            }
+            jobs = static_cast<uint32_t>(std::stoul(j));
+        }
+
+        // `extern`
+        const auto & maybeExterns = cliConfig.getValues("extern");
+        if (maybeExterns) {
+            externs = maybeExterns.unwrap();
+        }
+
+        // `include` and `exclude`
+        const auto & maybeIncludes = cliConfig.getValues("include");
+        if (maybeIncludes) {
+            includes = maybeIncludes.unwrap();
+        }
+        const auto & maybeExcludes = cliConfig.getValues("exclude");
+        if (maybeExcludes) {
+            excludes = maybeExcludes.unwrap();
+        }
+
+        // `emit-meta`
+        const auto & maybeEmitMeta = cliConfig.getSingleValue("emit-meta");
+        if (maybeEmitMeta) {
+            emitMeta = maybeEmitMeta.unwrap();
+        }
+
+        // `cache-size`
+        const auto & maybeCacheSize = cliConfig.getSingleValue("cache-size");
+        if (maybeCacheSize) {
+            const auto & cs = maybeCacheSize.unwrap();
+            if (cs.empty() or cs.find_first_not_of("0123456789") != std::string::npos) {
+                throw std::logic_error("Invalid value for `cache-size` cli argument, expected a number of megabytes");
+            }
+            cacheSizeMb = static_cast<uint32_t>(std::stoul(cs));
+        }
+
+        // `io`
+        const auto & maybeIo = cliConfig.getSingleValue("io");
+        if (maybeIo) {
+            const auto & io = maybeIo.unwrap();
+            if (io == "auto") {
+                ioBackend = IoBackend::Auto;
+            } else if (io == "uring") {
+                ioBackend = IoBackend::Uring;
+            } else if (io == "threads") {
+                ioBackend = IoBackend::Threads;
+            } else {
+                throw std::logic_error("Unhandled value for `io` cli argument");
+            }
+        }
+
         // Apply bool args //
         dev = cliConfig.is("dev");
+        cache = cliConfig.is("cache");
+        watch = cliConfig.is("watch");
+        inMemory = cliConfig.is("in-memory");
     }
 
     // Checkers //
@@ -81,7 +156,54 @@ namespace jc::common {
         return dev;
     }
 
+    bool Config::checkCache() const {
+        return cache;
+    }
+
+    bool Config::checkWatch() const {
+        return watch;
+    }
+
+    bool Config::checkInMemory() const {
+        return inMemory;
+    }
+
+    size_t Config::getCacheSize() const {
+        return static_cast<size_t>(cacheSizeMb) * 1024 * 1024;
+    }
+
     const std::string & Config::getRootFile() const {
         return rootFile;
     }
+
+    uint32_t Config::getMaxNesting() const {
+        return maxNesting;
+    }
+
+    const std::vector<std::string> & Config::getExterns() const {
+        return externs;
+    }
+
+    const std::vector<std::string> & Config::getIncludes() const {
+        return includes;
+    }
+
+    const std::vector<std::string> & Config::getExcludes() const {
+        return excludes;
+    }
+
+    const std::string & Config::getEmitMeta() const {
+        return emitMeta;
+    }
+
+    Config::IoBackend Config::getIoBackend() const {
+        return ioBackend;
+    }
+
+    uint32_t Config::getJobs() const {
+        if (jobs == 0) {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+        return jobs;
+    }
 }
@@ -0,0 +1,214 @@
+#include "core/CompileCache.h"
+
+#include <cstring>
+#include <fstream>
+#include <random>
+
+#include "fs/MappedFile.h"
+
+namespace jc::core {
+    namespace {
+        template<class T>
+        void appendRaw(std::string & buffer, const T & value) {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        /// Bounds-checked sequential reader over mapped entry
+        struct EntryReader {
+            const uint8_t * data;
+            size_t size;
+            size_t offset{0};
+            bool failed{false};
+
+            template<class T>
+            T read() {
+                T value{};
+                if (offset + sizeof(T) > size) {
+                    failed = true;
+                    return value;
+                }
+                std::memcpy(&value, data + offset, sizeof(T));
+                offset += sizeof(T);
+                return value;
+            }
+
+            std::string readStr(uint32_t len) {
+                if (offset + len > size) {
+                    failed = true;
+                    return "";
+                }
+                std::string str(reinterpret_cast<const char*>(data + offset), len);
+                offset += len;
+                return str;
+            }
+        };
+    }
+
+    CompileCache::CompileCache(const std_fs::path & dir, size_t maxBytes)
+        : dir(dir), maxBytes(maxBytes), buildId(computeBuildId()) {
+        std::error_code ec;
+        std_fs::create_directories(dir, ec);
+        if (ec) {
+            log.warn("Failed to create cache directory", dir, ":", ec.message());
+        }
+    }
+
+    utils::hash::Hash128 CompileCache::keyFor(const utils::hash::Hash128 & contentHash) const {
+        return utils::hash::Hasher128().add(buildId).add(contentHash).digest();
+    }
+
+    dt::Option<parser::token_list> CompileCache::loadTokens(
+        const utils::hash::Hash128 & key,
+        span::file_id_t fileId,
+        size_t sourceSize
+    ) {
+        const auto path = entryPath(key, TOKENS_KIND);
+        fs::MappedFile file;
+        if (not file.open(path)) {
+            stats.misses++;
+            return dt::None;
+        }
+
+        EntryReader reader{file.data(), file.size()};
+        const auto magic = reader.read<uint32_t>();
+        const auto version = reader.read<uint32_t>();
+        const auto count = reader.read<uint32_t>();
+        if (reader.failed or magic != MAGIC or version != VERSION) {
+            stats.misses++;
+            return dt::None;
+        }
+
+        // Each record is at least kind, pos, len and value length, a corrupt count must not drive the reservation
+        constexpr size_t minRecordSize = sizeof(uint8_t) + 3 * sizeof(uint32_t);
+        if (count > (file.size() - reader.offset) / minRecordSize) {
+            stats.misses++;
+            return dt::None;
+        }
+
+        parser::token_list tokens;
+        tokens.reserve(count);
+        for (uint32_t i = 0; i < count and not reader.failed; i++) {
+            const auto kind = reader.read<uint8_t>();
+            const auto pos = reader.read<uint32_t>();
+            const auto len = reader.read<uint32_t>();
+            const auto valLen = reader.read<uint32_t>();
+            if (kind > static_cast<uint8_t>(parser::TokenKind::None)) {
+                reader.failed = true;
+                break;
+            }
+            parser::Token token(static_cast<parser::TokenKind>(kind), reader.readStr(valLen));
+            token.span = span::Span(pos, len, fileId);
+            tokens.emplace_back(std::move(token));
+        }
+        if (reader.failed) {
+            stats.misses++;
+            return dt::None;
+        }
+
+        // Touch entry, eviction removes least recently used ones
+        std::error_code ec;
+        std_fs::last_write_time(path, std_fs::file_time_type::clock::now(), ec);
+
+        stats.hits++;
+        stats.bytesSaved += sourceSize;
+        return tokens;
+    }
+
+    void CompileCache::storeTokens(const utils::hash::Hash128 & key, const parser::token_list & tokens) {
+        std::string data;
+        appendRaw(data, MAGIC);
+        appendRaw(data, VERSION);
+        appendRaw(data, static_cast<uint32_t>(tokens.size()));
+        for (const auto & token : tokens) {
+            appendRaw(data, static_cast<uint8_t>(token.kind));
+            appendRaw(data, static_cast<uint32_t>(token.span.getPos()));
+            appendRaw(data, static_cast<uint32_t>(token.span.getLen()));
+            appendRaw(data, static_cast<uint32_t>(token.val.size()));
+            data += token.val;
+        }
+
+        // Temporary name is unique per writer, rename is atomic within one filesystem
+        const auto path = entryPath(key, TOKENS_KIND);
+        auto tmpPath = path;
+        tmpPath += ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            if (not file.is_open()) {
+                return;
+            }
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (not file.good()) {
+                file.close();
+                std::error_code ec;
+                std_fs::remove(tmpPath, ec);
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std_fs::rename(tmpPath, path, ec);
+        if (ec) {
+            std_fs::remove(tmpPath, ec);
+            return;
+        }
+        stats.stored++;
+    }
+
+    void CompileCache::evict() {
+        struct CacheEntry {
+            std_fs::path path;
+            std_fs::file_time_type time;
+            size_t size;
+        };
+
+        std::vector<CacheEntry> entries;
+        size_t totalSize = 0;
+        std::error_code ec;
+        for (const auto & entry : std_fs::directory_iterator(dir, ec)) {
+            // Only complete entries are evicted: temporary files may be renamed by other writers right now,
+            //  other files (e.g. tree manifest) are not cache entries
+            if (not entry.is_regular_file(ec) or entry.path().extension() != std::string(".") + TOKENS_KIND) {
+                continue;
+            }
+            const auto size = static_cast<size_t>(entry.file_size(ec));
+            entries.push_back({entry.path(), entry.last_write_time(ec), size});
+            totalSize += size;
+        }
+
+        if (totalSize <= maxBytes) {
+            return;
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const CacheEntry & lhs, const CacheEntry & rhs) {
+            return lhs.time < rhs.time;
+        });
+        for (const auto & entry : entries) {
+            if (totalSize <= maxBytes) {
+                break;
+            }
+            if (std_fs::remove(entry.path, ec)) {
+                totalSize -= entry.size;
+                stats.evicted++;
+            }
+        }
+    }
+
+    std_fs::path CompileCache::entryPath(const utils::hash::Hash128 & key, const std::string & kind) const {
+        return dir / (key.toString() + "." + kind);
+    }
+
+    utils::hash::Hash128 CompileCache::computeBuildId() {
+        // Build id changes with compiler binary, so entries written by another build are never hit
+        utils::hash::Hasher128 hasher;
+        hasher.add(static_cast<uint64_t>(VERSION));
+        std::error_code ec;
+        const auto exe = std_fs::read_symlink("/proc/self/exe", ec);
+        if (not ec) {
+            hasher.add(static_cast<uint64_t>(std_fs::file_size(exe, ec)));
+            hasher.add(static_cast<uint64_t>(std_fs::last_write_time(exe, ec).time_since_epoch().count()));
+        } else {
+            hasher.add(std::string(__DATE__ " " __TIME__));
+        }
+        return hasher.digest();
+    }
+}
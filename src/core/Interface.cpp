@@ -3,7 +3,9 @@
 // Strange track, but I like it: https://open.spotify.com/track/3dBKhZCi905UfyeodO8Epl?si=e36d5b4b2cad43d2
 
 namespace jc::core {
-    Interface::Interface() : config(Config::getInstance()) {}
+    Interface::Interface() : Interface(std::make_shared<fs::DiskVfs>()) {}
+
+    Interface::Interface(fs::vfs_ptr vfs) : config(Config::getInstance()), vfs(std::move(vfs)) {}
 
     void Interface::compile() {
         eachStageBenchmarks = config.checkBenchmark(Config::Benchmark::EachStage);
@@ -11,6 +13,7 @@ namespace jc::core {
         try {
             beginFinalBench();
 
+            dirtyFiles.clear();
             init();
 
             // Note: AstPrinter is a debug tool, so it allows to accept ill-formed AST
@@ -18,9 +21,13 @@ namespace jc::core {
 
             // AST Stage //
             parse();
+            dirtyFiles.insert(parsedFiles.begin(), parsedFiles.end());
             printDirTree();
             printAst(ast::AstPrinterMode::Parsing);
+            printAstStats();
             checkSuggestions();
+            hashAst();
+            indexAst();
             lintAst();
 
             // Name resolution //
@@ -30,6 +37,7 @@ namespace jc::core {
 
             printBenchmarks();
             printFinalBench();
+            dirtyFiles.clear();
         } catch (std::exception & e) {
             log.dev("Something went wrong:", e.what());
             log.dev("Some debug info:");
@@ -43,29 +51,104 @@ namespace jc::core {
     void Interface::init() {
         log.dev("Initialization...");
         sess = std::make_shared<sess::Session>();
+
+        const auto & projectDir = fs::normalizeDir(fs::std_fs::path(config.getRootFile()).parent_path());
+        initPathFilter(projectDir);
+
+        if (config.checkCache()) {
+            cache = std::make_unique<CompileCache>(projectDir / ".jacy-cache", config.getCacheSize());
+
+            if (vfs->isDisk()) {
+                manifest = std::make_unique<fs::TreeManifest>();
+                manifestPath = projectDir / ".jacy-cache" / "tree.manifest";
+                if (not manifest->load(manifestPath, projectDir, ".jc", pathFilter.fingerprint())) {
+                    log.dev("No valid tree manifest found, all sources will be read");
+                }
+            }
+        }
+    }
+
+    void Interface::initPathFilter(const fs::std_fs::path & projectDir) {
+        pathFilter = fs::PathFilter(projectDir);
+        for (const auto & include : config.getIncludes()) {
+            pathFilter.addInclude(include);
+        }
+        for (const auto & exclude : config.getExcludes()) {
+            pathFilter.addExclude(exclude);
+        }
+
+        const auto & ignoreFile = vfs->read(projectDir / fs::PathFilter::IGNORE_FILE);
+        if (ignoreFile.ok) {
+            log.dev("Apply ignore file", projectDir / fs::PathFilter::IGNORE_FILE);
+            pathFilter.addIgnoreFile(ignoreFile.view());
+        }
     }
 
     // Parsing //
     void Interface::parse() {
         log.dev("Parsing...");
+        parsedFiles.clear();
 
         const auto & rootFileName = config.getRootFile();
-        const auto & rootFileEntry = fs::readfile(rootFileName);
-        auto rootFile = std::move(parseFile(rootFileEntry));
-        log.dev("Project directory:", rootFileEntry->getPath().parent_path());
-        auto nestedModules = parseDir(
-            fs::readDirRec(rootFileEntry->getPath().parent_path(), ".jc"),
-            rootFileName
-        );
-        auto rootModule = std::make_unique<ast::RootModule>(std::move(rootFile), std::move(nestedModules));
+        const auto & rootFileEntry = vfs->fileEntry(rootFileName);
+        const auto & projectDir = fs::normalizeDir(rootFileEntry->getPath().parent_path());
+        log.dev("Project directory:", projectDir);
+
+        // With manifest, unchanged directories are not listed and files are only stat'ed
+        if (manifest) {
+            manifest->beginWalk(projectDir, ".jc", pathFilter.fingerprint());
+        }
+        // Excluded directories are pruned by the walk, they are never opened
+        const auto & dirTree = vfs->readDirRec(projectDir, ".jc", config.getJobs(), &pathFilter, manifest.get());
+        if (manifest) {
+            manifest->endWalk();
+        }
+
+        // Files are read and lexed in background, each one is parsed as soon as it is lexed
+        startPipeline(rootFileEntry, dirTree, rootFileName);
+        try {
+            auto rootFile = std::move(parseFile(rootFileEntry));
+            auto nestedModules = parseDir(dirTree, rootFileName);
+            auto rootModule = std::make_unique<ast::RootModule>(std::move(rootFile), std::move(nestedModules));
+
+            party = std::make_unique<ast::Party>(std::move(rootModule));
+        } catch (...) {
+            stopPipeline();
+            reusedFiles.clear();
+            throw;
+        }
+        stopPipeline();
+
+        // Files left unused were removed from party
+        for (const auto & unused : reusedFiles) {
+            dropFile(*unused.second);
+        }
+        reusedFiles.clear();
 
-        party = std::make_unique<ast::Party>(std::move(rootModule));
+        if (manifest and not manifest->save(manifestPath)) {
+            log.warn("Failed to save tree manifest", manifestPath);
+        }
+        if (cache) {
+            cache->evict();
+        }
+    }
+
+    void Interface::hashAst() {
+        log.dev("Hashing AST...");
+
+        structHasher.hash(sess, *party.unwrap());
+    }
+
+    void Interface::indexAst() {
+        log.dev("Building parent index...");
+
+        parentIndexBuilder.build(sess, *party.unwrap());
     }
 
     void Interface::lintAst() {
         log.dev("Linting...");
 
-        linter.lint(*party.unwrap());
+        linter.lint(sess, *party.unwrap()).unwrap(sess);
     }
 
     ast::dir_module_ptr Interface::parseDir(const fs::entry_ptr & dir, const std::string & ignore) {
@@ -76,9 +159,12 @@ namespace jc::core {
         const auto & name = dir->getPath().filename().string();
         ast::module_list nestedModules;
         for (const auto & entry : dir->getSubModules()) {
+            if (not isModuleEntry(entry, ignore)) {
+                continue;
+            }
             if (entry->isDir()) {
                 nestedModules.emplace_back(parseDir(entry));
-            } else if (not ignore.empty() and entry->getPath().filename() == ignore) {
+            } else {
                 nestedModules.emplace_back(parseFile(entry));
             }
         }
@@ -88,34 +174,345 @@ namespace jc::core {
 
     ast::file_module_ptr Interface::parseFile(const fs::entry_ptr & file) {
         const auto fileId = sess->sourceMap.addSource(file->getPath().string());
-        sess->sourceMap.setSrc(fileId, std::move(file->extractContent()));
+        const auto & reused = reusedFiles.find(fileId);
+        if (reused != reusedFiles.end()) {
+            auto fileModule = std::move(reused->second);
+            reusedFiles.erase(reused);
+            return fileModule;
+        }
+        parsedFiles.push_back(fileId);
+
         const auto parseSess = std::make_shared<parser::ParseSess>(fileId);
 
-        beginBench();
-        auto lexerResult = lexer.lex(parseSess, file->extractContent());
-        endBench(file->getPath().string(), BenchmarkKind::Lexing);
+        auto lexedFile = takeLexedFile(fileId);
+        const auto & fileTokens = lexedFile.tokens;
+        addBench(file->getPath().string(), BenchmarkKind::Lexing, lexedFile.lexingMs);
 
-        log.dev("Tokenize file", file->getPath());
-        auto fileTokens = std::move(std::move(lexerResult));
+        log.dev(lexedFile.cached ? "Load cached tokens of file" : "Tokenize file", file->getPath());
 
         printSource(fileId);
         printTokens(fileId, fileTokens);
+        astStats.addTokens(fileTokens);
 
         log.dev("Parse file", file->getPath());
 
         beginBench();
+        const auto firstNodeId = static_cast<ast::node_id>(sess->nodeMap.idsCount());
         auto [parsedFile, parserSuggestions] = parser.parse(sess, parseSess, fileTokens).extract();
+        const auto endNodeId = static_cast<ast::node_id>(sess->nodeMap.idsCount());
         endBench(file->getPath().string(), BenchmarkKind::Parsing);
 
+        if (parserSuggestions.empty()) {
+            erroneousFiles.erase(fileId);
+        } else {
+            erroneousFiles.insert(fileId);
+        }
         collectSuggestions(std::move(parserSuggestions));
 
         return std::make_unique<ast::FileModule>(
             file->getPath().filename().string(),
             fileId,
-            std::move(parsedFile)
+            std::move(parsedFile),
+            firstNodeId,
+            endNodeId
         );
     }
 
+    // Source loading //
+    bool Interface::isModuleEntry(const fs::entry_ptr & entry, const std::string & ignore) {
+        if (entry->isDir()) {
+            // Hidden directories (e.g. `.jacy-cache`) are not modules
+            return entry->getPath().filename().string().front() != '.';
+        }
+        // Note: Root file is parsed separately, so it is ignored in its directory
+        return ignore.empty() or entry->getPath().filename() != fs::std_fs::path(ignore).filename();
+    }
+
+    void Interface::collectSources(
+        const fs::entry_ptr & dir,
+        const std::string & ignore,
+        std::vector<fs::path> & paths
+    ) {
+        for (const auto & entry : dir->getSubModules()) {
+            if (not isModuleEntry(entry, ignore)) {
+                continue;
+            }
+            if (entry->isDir()) {
+                collectSources(entry, "", paths);
+            } else {
+                paths.emplace_back(entry->getPath());
+            }
+        }
+    }
+
+    void Interface::startPipeline(
+        const fs::entry_ptr & rootFile,
+        const fs::entry_ptr & dir,
+        const std::string & ignore
+    ) {
+        // Paths are collected in order of parsing, so pipeline completes files in order they are needed
+        std::vector<fs::path> paths{rootFile->getPath()};
+        collectSources(dir, ignore, paths);
+
+        // All files are registered before pipeline starts, so its thread never touches `SourceMap`
+        std::vector<span::file_id_t> fileIds;
+        fileIds.reserve(paths.size());
+        // Unchanged files of previous party are reused, they are not read again
+        std::vector<fs::path> changedPaths;
+        // Files which content hashes are known may not be read, if their tokens are cached
+        std::vector<dt::Option<utils::hash::Hash128>> knownHashes;
+        for (auto & path : paths) {
+            const auto fileId = sess->sourceMap.addSource(path.string());
+            if (reusedFiles.find(fileId) != reusedFiles.end()) {
+                continue;
+            }
+            fileIds.push_back(fileId);
+            if (manifest) {
+                knownHashes.emplace_back(manifest->getHash(path));
+            }
+            changedPaths.emplace_back(std::move(path));
+        }
+        paths = std::move(changedPaths);
+
+        const auto ioBackend = config.getIoBackend();
+        pipeline = std::make_unique<SourcePipeline>(
+            vfs,
+            std::move(paths),
+            std::move(fileIds),
+            std::move(knownHashes),
+            config.getJobs(),
+            ioBackend != Config::IoBackend::Threads,
+            SOURCE_QUEUE_CAPACITY,
+            cache.get()
+        );
+
+        const auto backend = pipeline->getStats().backend;
+        if (ioBackend == Config::IoBackend::Uring and backend != fs::SourceLoader::Backend::Uring) {
+            if (vfs->isDisk() and not vfs->mapsFiles()) {
+                log.warn("io_uring is not used in watch mode, sources are loaded by threads");
+            } else {
+                log.warn("io_uring is not available, sources are loaded by threads");
+            }
+        }
+        log.dev("Loading sources with", fs::SourceLoader::backendToString(backend));
+    }
+
+    void Interface::stopPipeline() {
+        if (not pipeline) {
+            return;
+        }
+        pipeline->stop();
+        pipelineStats = pipeline->getStats();
+        pipeline.reset();
+    }
+
+    LexedFile Interface::takeLexedFile(span::file_id_t fileId) {
+        if (not pipeline) {
+            common::Logger::devPanic("Called `Interface::takeLexedFile` without source pipeline");
+        }
+        auto lexedFile = pipeline->next();
+        if (lexedFile.fileId != fileId) {
+            common::Logger::devPanic(
+                "Source pipeline order mismatch: expected fileId", fileId, "got", lexedFile.fileId
+            );
+        }
+
+        auto & loaded = lexedFile.loaded;
+        if (not loaded.ok) {
+            log.error("Failed to read file", sess->sourceMap.getSourceFile(fileId).path);
+            throw std::runtime_error("Stop due to file reading failure");
+        }
+        if (loaded.mapping) {
+            sess->sourceMap.setMappedSrc(fileId, std::move(loaded.mapping), lexedFile.contentHash);
+        } else {
+            sess->sourceMap.setSrc(fileId, std::move(loaded.contents), lexedFile.contentHash);
+        }
+        if (manifest) {
+            manifest->setHash(sess->sourceMap.getSourceFile(fileId).path, lexedFile.contentHash);
+        }
+
+        if (lexedFile.error) {
+            std::rethrow_exception(lexedFile.error);
+        }
+        return lexedFile;
+    }
+
+    // Watch mode //
+    void Interface::watch() {
+        if (not vfs->isDisk()) {
+            log.error("Watch mode requires sources on disk");
+            return;
+        }
+        const auto & projectDir = fs::normalizeDir(fs::std_fs::path(config.getRootFile()).parent_path());
+        fs::Watcher watcher(projectDir, ".jc");
+        if (not watcher.isOpen()) {
+            log.error("Watch mode is not supported on this system");
+            return;
+        }
+        common::Logger::nl();
+        log.info("Watching", projectDir, "for changes");
+
+        while (true) {
+            const auto & changedPaths = watcher.wait(WATCH_DEBOUNCE);
+            if (changedPaths.empty()) {
+                log.error("Stop watching due to file watcher failure");
+                return;
+            }
+            recompile(changedPaths);
+        }
+    }
+
+    void Interface::recompile(const std::vector<fs::path> & changedPaths) {
+        watchIteration++;
+        log.info("Iteration " + std::to_string(watchIteration) + ":", changedPaths.size(), "path(s) changed");
+
+        // Previous compilation stopped before party was built, start from scratch
+        if (not sess or not party) {
+            suggestions.clear();
+            compile();
+            return;
+        }
+
+        const auto iterationStart = bench();
+        benchmarks.clear();
+        suggestions.clear();
+
+        try {
+            // Changed paths are normalized by watcher, source paths are stored as found by directory walk
+            std::unordered_map<std::string, span::file_id_t> knownFiles;
+            const auto & sources = sess->sourceMap.getSources();
+            for (span::file_id_t fileId = 0; fileId < sources.size(); fileId++) {
+                knownFiles.emplace(sources.at(fileId).path.lexically_normal().string(), fileId);
+            }
+            std::unordered_set<span::file_id_t> changedFiles;
+            for (const auto & path : changedPaths) {
+                const auto & known = knownFiles.find(path.string());
+                if (known != knownFiles.end()) {
+                    changedFiles.insert(known->second);
+                    continue;
+                }
+                if (path.extension() == ".jc") {
+                    // New or removed file
+                    continue;
+                }
+                // Directory changed as a whole (e.g. moved or its events are lost), so files inside of it are re-read
+                for (const auto & file : knownFiles) {
+                    if (fs::isInsideDir(file.first, path)) {
+                        changedFiles.insert(file.second);
+                    }
+                }
+            }
+
+            // Only changed and new files are parsed, others are moved into the new party
+            auto stageStart = bench();
+            releaseParty(changedFiles);
+            parse();
+            dirtyFiles.insert(parsedFiles.begin(), parsedFiles.end());
+            const auto parsingMs = std::chrono::duration<double, milli_ratio>(bench() - stageStart).count();
+            checkSuggestions();
+
+            stageStart = bench();
+            std::vector<const ast::FileModule*> files;
+            collectFileModules(*party.unwrap()->getRootModule(), files);
+            // Parent index is used by linter, so file is indexed before it is linted
+            for (const auto & file : files) {
+                if (dirtyFiles.find(file->getFileId()) != dirtyFiles.end()) {
+                    structHasher.hashFile(sess, *file);
+                    parentIndexBuilder.buildFile(sess, *file);
+                    linter.lintFile(sess, *file).unwrap(sess);
+                }
+            }
+            const auto analysisMs = std::chrono::duration<double, milli_ratio>(bench() - stageStart).count();
+
+            // Module tree and imports are cheap to rebuild, bodies of unchanged files are re-resolved
+            //  only if names they use now resolve differently
+            stageStart = bench();
+            moduleTreeBuilder.build(sess, *party.unwrap()).unwrap(sess);
+            importResolver.resolve(sess).unwrap(sess);
+            const auto moduleTreeMs = std::chrono::duration<double, milli_ratio>(bench() - stageStart).count();
+            emitModuleMeta();
+
+            stageStart = bench();
+            nameResolver.resolveIncremental(sess, *party.unwrap(), dirtyFiles).unwrap(sess);
+            const auto namesMs = std::chrono::duration<double, milli_ratio>(bench() - stageStart).count();
+            printAst(ast::AstPrinterMode::Names);
+            checkSuggestions();
+
+            dirtyFiles.clear();
+
+            printBenchmarks();
+            common::Logger::print(
+                "Iteration", watchIteration, "done in",
+                std::chrono::duration<double, milli_ratio>(bench() - iterationStart).count(), "ms:",
+                parsedFiles.size(), "of", files.size(), "files parsed in", parsingMs, "ms, analysis",
+                analysisMs, "ms, module tree", moduleTreeMs, "ms, name resolution", namesMs, "ms"
+            );
+            common::Logger::nl();
+        } catch (std::exception & e) {
+            log.dev("Iteration", watchIteration, "stopped:", e.what());
+        }
+    }
+
+    void Interface::releaseParty(const std::unordered_set<span::file_id_t> & changedFiles) {
+        auto rootModule = party.unwrap()->takeRootModule();
+        party = dt::None;
+
+        reusedFiles.clear();
+        reuseFile(rootModule->takeRootFile(), changedFiles);
+        releaseModules(rootModule->takeRootDir()->takeModules(), changedFiles);
+    }
+
+    void Interface::releaseModules(
+        ast::module_list && modules,
+        const std::unordered_set<span::file_id_t> & changedFiles
+    ) {
+        for (auto & module : modules) {
+            if (module->kind == ast::Module::Kind::File) {
+                reuseFile(
+                    ast::file_module_ptr(static_cast<ast::FileModule*>(module.release())),
+                    changedFiles
+                );
+            } else if (module->kind == ast::Module::Kind::Dir) {
+                releaseModules(static_cast<ast::DirModule&>(*module).takeModules(), changedFiles);
+            }
+        }
+    }
+
+    void Interface::reuseFile(ast::file_module_ptr && file, const std::unordered_set<span::file_id_t> & changedFiles) {
+        const auto fileId = file->getFileId();
+        // Parser suggestions are not kept, file with errors is parsed again to report them
+        if (changedFiles.find(fileId) == changedFiles.end() and erroneousFiles.find(fileId) == erroneousFiles.end()) {
+            reusedFiles.emplace(fileId, std::move(file));
+        } else {
+            dropFile(*file);
+        }
+    }
+
+    void Interface::dropFile(const ast::FileModule & file) {
+        sess->nodeMap.eraseNodes(file.getFirstNodeId(), file.getEndNodeId());
+    }
+
+    void Interface::collectFileModules(const ast::Module & module, std::vector<const ast::FileModule*> & files) const {
+        switch (module.kind) {
+            case ast::Module::Kind::File: {
+                files.push_back(static_cast<const ast::FileModule*>(&module));
+                break;
+            }
+            case ast::Module::Kind::Dir: {
+                for (const auto & nested : static_cast<const ast::DirModule&>(module).getModules()) {
+                    collectFileModules(*nested, files);
+                }
+                break;
+            }
+            case ast::Module::Kind::Root: {
+                const auto & rootModule = static_cast<const ast::RootModule&>(module);
+                files.push_back(rootModule.getRootFile().get());
+                collectFileModules(*rootModule.getRootDir(), files);
+                break;
+            }
+        }
+    }
+
     // Debug //
     void Interface::printDirTree() {
         if (not config.checkPrint(Config::PrintKind::DirTree)) {
@@ -130,11 +527,14 @@ namespace jc::core {
             return;
         }
         const auto & source = sess->sourceMap.getSourceFile(fileId);
-        log.info("Printing source for file", source.path, "by fileId", fileId, "(`--print source`)");
+        log.info(
+            "Printing source for file", source.path, "by fileId", fileId,
+            "[ Content hash:", source.contentHash.toString(), "] (`--print source`)"
+        );
 
-        const auto & sourceLines = source.src.unwrap("Interface::printSource");
-        for (size_t i = 0; i < sourceLines.size(); i++) {
-            log.raw(i + 1, "|", sourceLines.at(i));
+        const auto linesCount = sess->sourceMap.getLinesCount(fileId);
+        for (size_t i = 0; i < linesCount; i++) {
+            log.raw(i + 1, "|", utils::str::trimEnd(sess->sourceMap.getLine(fileId, i), '\n')).nl();
         }
         log.nl();
     }
@@ -168,13 +568,72 @@ namespace jc::core {
         common::Logger::nl();
     }
 
+    void Interface::printAstStats() {
+        const auto text = config.checkPrint(Config::PrintKind::AstStats);
+        const auto json = config.checkPrint(Config::PrintKind::AstStatsJson);
+        if (not text and not json) {
+            return;
+        }
+        astStats.collect(sess, *party.unwrap());
+        if (text) {
+            common::Logger::nl();
+            log.info("Printing AST statistics (`--print ast-stats`)");
+            astStats.print();
+            common::Logger::nl();
+        }
+        if (json) {
+            astStats.printJson();
+        }
+    }
+
     // Name resolution //
     void Interface::resolveNames() {
         log.dev("Resolving names...");
 
+        beginBench();
+        loadExterns();
         moduleTreeBuilder.build(sess, *party.unwrap()).unwrap(sess);
+        importResolver.resolve(sess).unwrap(sess);
+        endBench("Party", BenchmarkKind::ModuleTreeBuilding);
+
+        emitModuleMeta();
+
         modulePrinter.print(sess->modTreeRoot.unwrap());
+
+        beginBench();
         nameResolver.resolve(sess, *party.unwrap()).unwrap(sess);
+        endBench("Party", BenchmarkKind::NameResolution);
+    }
+
+    void Interface::loadExterns() {
+        // Note: Extern definitions get ids after all AST nodes, so they are loaded after parsing
+        if (not sess->externMods.empty()) {
+            return;
+        }
+        for (const auto & path : config.getExterns()) {
+            span::Symbol partyName;
+            std::string error;
+            const auto & mod = resolve::ModuleMeta::load(sess, path, partyName, error);
+            if (not mod) {
+                log.error("Failed to load module metadata `" + path + "`:", error);
+                throw std::runtime_error("Stop due to module metadata loading failure");
+            }
+            log.dev("Loaded precompiled party", partyName.toString(), "from", path);
+            sess->externMods.emplace(partyName, mod.unwrap());
+        }
+    }
+
+    void Interface::emitModuleMeta() {
+        const auto & path = config.getEmitMeta();
+        if (path.empty()) {
+            return;
+        }
+        const auto & partyName = fs::std_fs::path(config.getRootFile()).stem().string();
+        if (not resolve::ModuleMeta::write(sess, sess->modTreeRoot.unwrap(), partyName, path)) {
+            log.error("Failed to write module metadata `" + path + "`");
+            throw std::runtime_error("Stop due to module metadata writing failure");
+        }
+        log.info("Module metadata of party `" + partyName + "` written to", path);
     }
 
     // Suggestions //
@@ -218,6 +677,14 @@ namespace jc::core {
         if (not lastBench) {
             common::Logger::devPanic("Called `Interface::endBench` with None beginning bench");
         }
+        addBench(name, kind, std::chrono::duration<double, milli_ratio>(bench() - lastBench.unwrap()).count());
+        lastBench = dt::None;
+    }
+
+    void Interface::addBench(const std::string & name, BenchmarkKind kind, double ms) {
+        if (not eachStageBenchmarks) {
+            return;
+        }
         std::string formatted = name + " ";
         switch (kind) {
             case BenchmarkKind::Lexing: {
@@ -228,13 +695,25 @@ namespace jc::core {
                 formatted += "parsing";
                 break;
             }
+            case BenchmarkKind::ModuleTreeBuilding: {
+                formatted += "module tree building";
+                break;
+            }
+            case BenchmarkKind::NameResolution: {
+                formatted += "name resolution";
+                break;
+            }
         }
-        auto end = bench();
-        benchmarks.emplace(
-            formatted,
-            std::chrono::duration<double, milli_ratio>(end - lastBench.unwrap()).count()
+        benchmarks.emplace(formatted, ms);
+    }
+
+    void Interface::printQueueStats(const std::string & name, const utils::thread::QueueStats & stats) noexcept {
+        common::Logger::print(
+            " ", name, "queue: capacity", stats.capacity,
+            "| max depth", stats.maxDepth, "| avg depth", stats.avgDepth(),
+            "| producer stalled", stats.producerStallMs, "ms | consumer stalled", stats.consumerStallMs, "ms"
         );
-        lastBench = dt::None;
+        common::Logger::nl();
     }
 
     void Interface::printBenchmarks() noexcept {
@@ -243,6 +722,43 @@ namespace jc::core {
                 common::Logger::print(it.first, "done in", it.second, "ms");
                 common::Logger::nl();
             }
+            if (pipelineStats) {
+                const auto & stats = pipelineStats.unwrap();
+                common::Logger::print(
+                    "Source pipeline (" + fs::SourceLoader::backendToString(stats.backend) + "):",
+                    "lexing busy", stats.lexingMs, "ms"
+                );
+                common::Logger::nl();
+                printQueueStats("read -> lex", stats.readQueue);
+                printQueueStats("lex -> parse", stats.lexQueue);
+
+                const auto & hashing = stats.hashing;
+                const auto throughput = hashing.ms > 0
+                    ? static_cast<double>(hashing.bytes) / 1e6 / (hashing.ms / 1000)
+                    : 0;
+                common::Logger::print(
+                    "Content hashing:", hashing.files, "files,", hashing.bytes, "bytes in", hashing.ms, "ms",
+                    "(" + std::to_string(static_cast<size_t>(throughput)), "MB/s)"
+                );
+                common::Logger::nl();
+            }
+            if (manifest) {
+                const auto & stats = manifest->getStats();
+                common::Logger::print(
+                    "Tree manifest:", stats.dirsListed, "dirs listed,", stats.dirsReused, "reused,",
+                    stats.files, "files stat'ed,", stats.filesChanged, "changed,",
+                    pipelineStats ? pipelineStats.unwrap().readsSkipped : 0, "reads skipped"
+                );
+                common::Logger::nl();
+            }
+            if (cache) {
+                const auto & stats = cache->getStats();
+                common::Logger::print(
+                    "Compilation cache:", stats.hits, "hits,", stats.misses, "misses,",
+                    stats.bytesSaved, "bytes saved,", stats.stored, "stored,", stats.evicted, "evicted"
+                );
+                common::Logger::nl();
+            }
         }
     }
 }
@@ -8,8 +8,24 @@ namespace jc::core {
     void Jacy::meow(int argc, const char ** argv) {
         try {
             cli.applyArgs(argc, argv);
-            common::Config::getInstance().applyCliConfig(cli.getConfig());
-            interface.compile();
+            auto & config = common::Config::getInstance();
+            config.applyCliConfig(cli.getConfig());
+
+            // In watch mode files are edited while their sources are kept, so they are not mapped
+            fs::vfs_ptr vfs = std::make_shared<fs::DiskVfs>(not config.checkWatch());
+            // Sources are preloaded before compilation starts, so its benchmarks do not include disk reads
+            if (config.checkInMemory()) {
+                const auto & projectDir = fs::std_fs::path(config.getRootFile()).parent_path();
+                const auto & memoryVfs = fs::MemoryVfs::fromDisk(projectDir, ".jc");
+                log.dev("Preloaded", memoryVfs->getFilesCount(), "source files into memory");
+                vfs = memoryVfs;
+            }
+
+            interface = std::make_unique<Interface>(vfs);
+            interface->compile();
+            if (config.checkWatch()) {
+                interface->watch();
+            }
         } catch (common::Error & e) {
             log.error(e.message);
             return;
@@ -0,0 +1,126 @@
+#include "core/SourcePipeline.h"
+
+namespace jc::core {
+    SourcePipeline::SourcePipeline(
+        fs::vfs_ptr vfs,
+        std::vector<std_fs::path> paths,
+        std::vector<span::file_id_t> fileIds,
+        std::vector<dt::Option<utils::hash::Hash128>> knownHashes,
+        size_t workers,
+        bool allowUring,
+        size_t queueCapacity,
+        CompileCache * cache
+    ) : vfs(std::move(vfs)),
+        paths(std::move(paths)),
+        fileIds(std::move(fileIds)),
+        knownHashes(std::move(knownHashes)),
+        cache(cache),
+        loader(this->vfs, pathsToLoad(), workers, allowUring, queueCapacity),
+        lexed(queueCapacity) {
+        thread = std::thread([this]() {
+            lexAll();
+        });
+    }
+
+    SourcePipeline::~SourcePipeline() {
+        stop();
+    }
+
+    LexedFile SourcePipeline::next() {
+        LexedFile file;
+        if (not lexed.pop(file)) {
+            common::Logger::devPanic("Called `SourcePipeline::next` on drained or stopped pipeline");
+        }
+        return file;
+    }
+
+    void SourcePipeline::stop() {
+        lexed.close();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    SourcePipeline::Stats SourcePipeline::getStats() {
+        Stats stats;
+        stats.backend = loader.getBackend();
+        stats.readQueue = loader.getStats();
+        stats.lexQueue = lexed.getStats();
+        // Note: Lexing time is written by pipeline thread, it is complete only after all files were taken
+        stats.lexingMs = lexingMs;
+        stats.readsSkipped = readsSkipped;
+        stats.hashing = loader.getHashingStats();
+        return stats;
+    }
+
+    bool SourcePipeline::isKnown(size_t index) const {
+        return cache and index < knownHashes.size() and knownHashes.at(index);
+    }
+
+    std::vector<std_fs::path> SourcePipeline::pathsToLoad() const {
+        std::vector<std_fs::path> loaded;
+        for (size_t index = 0; index < paths.size(); index++) {
+            if (not isKnown(index)) {
+                loaded.push_back(paths.at(index));
+            }
+        }
+        return loaded;
+    }
+
+    void SourcePipeline::lexAll() {
+        size_t loaderIndex = 0;
+        for (size_t index = 0; index < fileIds.size(); index++) {
+            LexedFile file;
+            file.fileId = fileIds.at(index);
+
+            try {
+                const bool known = isKnown(index);
+                if (known) {
+                    // Mapping does not read file, pages are touched only if tokens are not cached
+                    file.loaded = vfs->read(paths.at(index));
+                } else {
+                    file.loaded = loader.take(loaderIndex++);
+                }
+
+                if (not file.loaded.ok) {
+                    throw std::runtime_error("Stop due to file reading failure");
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                const auto source = file.loaded.view();
+                file.contentHash = known ? knownHashes.at(index).unwrap() : file.loaded.contentHash;
+
+                utils::hash::Hash128 cacheKey;
+                if (cache) {
+                    cacheKey = cache->keyFor(file.contentHash);
+                    auto cachedTokens = cache->loadTokens(cacheKey, file.fileId, source.size());
+                    if (cachedTokens) {
+                        file.tokens = std::move(cachedTokens.unwrap());
+                        file.cached = true;
+                        if (known) {
+                            readsSkipped++;
+                        }
+                    }
+                }
+                if (not file.cached) {
+                    file.tokens = lexer.lex(std::make_shared<parser::ParseSess>(file.fileId), source);
+                    if (cache) {
+                        cache->storeTokens(cacheKey, file.tokens);
+                    }
+                }
+
+                file.lexingMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start
+                ).count();
+                lexingMs += file.lexingMs;
+            } catch (...) {
+                file.error = std::current_exception();
+            }
+
+            if (not lexed.push(std::move(file))) {
+                return;
+            }
+        }
+        lexed.close();
+    }
+}
@@ -0,0 +1,121 @@
+#include "fs/MappedFile.h"
+
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JACY_FS_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace jc::fs {
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile && other) noexcept {
+        moveFrom(other);
+    }
+
+    MappedFile & MappedFile::operator=(MappedFile && other) noexcept {
+        if (this != &other) {
+            close();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::filesystem::path & path) {
+        close();
+
+#ifdef JACY_FS_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        const bool ok = map(fd, static_cast<size_t>(st.st_size));
+        // Note: Mapping stays valid after descriptor is closed
+        ::close(fd);
+        return ok;
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (not file.is_open()) {
+            return false;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        bytes = buffer.data();
+        length = buffer.size();
+        opened = true;
+        return true;
+#endif
+    }
+
+    bool MappedFile::map(int fd, size_t size) {
+        close();
+
+#ifdef JACY_FS_MMAP
+        length = size;
+        if (length == 0) {
+            // Empty file cannot be mapped
+            opened = true;
+            return true;
+        }
+        void * addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            length = 0;
+            return false;
+        }
+        bytes = static_cast<const uint8_t*>(addr);
+        mapped = true;
+        opened = true;
+        return true;
+#else
+        static_cast<void>(fd);
+        static_cast<void>(size);
+        return false;
+#endif
+    }
+
+    void MappedFile::prefetch() const {
+#ifdef JACY_FS_MMAP
+        if (mapped) {
+            ::madvise(const_cast<uint8_t*>(bytes), length, MADV_WILLNEED);
+        }
+#endif
+    }
+
+    void MappedFile::close() {
+#ifdef JACY_FS_MMAP
+        if (mapped) {
+            ::munmap(const_cast<uint8_t*>(bytes), length);
+        }
+#endif
+        buffer.clear();
+        bytes = nullptr;
+        length = 0;
+        opened = false;
+        mapped = false;
+    }
+
+    void MappedFile::moveFrom(MappedFile & other) {
+        bytes = other.bytes;
+        length = other.length;
+        opened = other.opened;
+        mapped = other.mapped;
+        buffer = std::move(other.buffer);
+        if (not mapped and opened) {
+            bytes = buffer.data();
+        }
+        other.bytes = nullptr;
+        other.length = 0;
+        other.opened = false;
+        other.mapped = false;
+    }
+}
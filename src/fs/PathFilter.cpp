@@ -0,0 +1,174 @@
+#include "fs/PathFilter.h"
+
+#include <cctype>
+
+#include "fs/fs.h"
+
+namespace jc::fs {
+    PathFilter::PathFilter(const std_fs::path & root)
+        : root(normalizeDir(root)) {}
+
+    void PathFilter::addInclude(const std::string & pattern) {
+        if (not pattern.empty()) {
+            includes.emplace_back(makeRule(pattern, false));
+        }
+    }
+
+    void PathFilter::addExclude(const std::string & pattern) {
+        if (not pattern.empty()) {
+            excludes.emplace_back(makeRule(pattern, true));
+        }
+    }
+
+    void PathFilter::addIgnoreFile(std::string_view contents) {
+        size_t lineBegin = 0;
+        while (lineBegin < contents.size()) {
+            auto lineEnd = contents.find('\n', lineBegin);
+            if (lineEnd == std::string_view::npos) {
+                lineEnd = contents.size();
+            }
+            auto line = contents.substr(lineBegin, lineEnd - lineBegin);
+            lineBegin = lineEnd + 1;
+
+            while (not line.empty() and std::isspace(static_cast<unsigned char>(line.back()))) {
+                line.remove_suffix(1);
+            }
+            while (not line.empty() and std::isspace(static_cast<unsigned char>(line.front()))) {
+                line.remove_prefix(1);
+            }
+            if (line.empty() or line.front() == '#') {
+                continue;
+            }
+            addExclude(std::string(line));
+        }
+    }
+
+    bool PathFilter::excludesDir(const std_fs::path & dir) const {
+        return excluded(dir, true);
+    }
+
+    bool PathFilter::excludesFile(const std_fs::path & file) const {
+        if (excluded(file, false)) {
+            return true;
+        }
+        if (includes.empty()) {
+            return false;
+        }
+        const auto & rel = file.lexically_relative(root).generic_string();
+        const auto & name = file.filename().string();
+        for (const auto & rule : includes) {
+            if (ruleMatches(rule, rel, name, false)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string PathFilter::fingerprint() const {
+        std::string fingerprint;
+        const auto append = [&](char kind, const Rule & rule) {
+            fingerprint += kind;
+            fingerprint += rule.pattern;
+            fingerprint += rule.dirOnly ? "/" : "";
+            fingerprint += rule.anchored ? "@\n" : "\n";
+        };
+        for (const auto & rule : includes) {
+            append('+', rule);
+        }
+        for (const auto & rule : excludes) {
+            append(rule.negated ? '!' : '-', rule);
+        }
+        return fingerprint;
+    }
+
+    bool PathFilter::globMatch(std::string_view pattern, std::string_view path) {
+        size_t pi = 0;
+        size_t si = 0;
+        while (pi < pattern.size()) {
+            const auto ch = pattern.at(pi);
+            if (ch == '*') {
+                if (pi + 1 < pattern.size() and pattern.at(pi + 1) == '*') {
+                    auto rest = pattern.substr(pi + 2);
+                    if (not rest.empty() and rest.front() == '/') {
+                        // `**/` matches zero or more whole directories
+                        rest.remove_prefix(1);
+                        for (size_t from = si; from <= path.size(); from++) {
+                            if ((from == si or path.at(from - 1) == '/') and globMatch(rest, path.substr(from))) {
+                                return true;
+                            }
+                        }
+                        return false;
+                    }
+                    for (size_t from = si; from <= path.size(); from++) {
+                        if (globMatch(rest, path.substr(from))) {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                const auto rest = pattern.substr(pi + 1);
+                for (size_t from = si; from <= path.size(); from++) {
+                    if (globMatch(rest, path.substr(from))) {
+                        return true;
+                    }
+                    if (from < path.size() and path.at(from) == '/') {
+                        break;
+                    }
+                }
+                return false;
+            }
+            if (si >= path.size()) {
+                return false;
+            }
+            if (ch == '?' ? path.at(si) == '/' : path.at(si) != ch) {
+                return false;
+            }
+            pi++;
+            si++;
+        }
+        return si == path.size();
+    }
+
+    PathFilter::Rule PathFilter::makeRule(std::string pattern, bool allowNegation) {
+        Rule rule;
+        if (allowNegation and pattern.front() == '!') {
+            rule.negated = true;
+            pattern.erase(0, 1);
+        }
+        while (not pattern.empty() and pattern.back() == '/') {
+            rule.dirOnly = true;
+            pattern.pop_back();
+        }
+        rule.anchored = pattern.find('/') != std::string::npos;
+        while (not pattern.empty() and pattern.front() == '/') {
+            pattern.erase(0, 1);
+        }
+        if (pattern.rfind("./", 0) == 0) {
+            pattern.erase(0, 2);
+        }
+        rule.pattern = std::move(pattern);
+        return rule;
+    }
+
+    bool PathFilter::ruleMatches(const Rule & rule, const std::string & rel, const std::string & name, bool isDir) {
+        if (rule.dirOnly and not isDir) {
+            return false;
+        }
+        return globMatch(rule.pattern, rule.anchored ? rel : name);
+    }
+
+    bool PathFilter::excluded(const std_fs::path & path, bool isDir) const {
+        if (excludes.empty()) {
+            return false;
+        }
+        const auto & rel = path.lexically_relative(root).generic_string();
+        const auto & name = path.filename().string();
+        bool isExcluded = false;
+        for (const auto & rule : excludes) {
+            if (rule.negated == isExcluded and ruleMatches(rule, rel, name, isDir)) {
+                isExcluded = not rule.negated;
+            }
+        }
+        return isExcluded;
+    }
+}
@@ -0,0 +1,526 @@
+#include "fs/SourceLoader.h"
+
+#include <deque>
+#include <cerrno>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define JACY_FS_URING 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+#endif
+
+namespace jc::fs {
+#ifdef JACY_FS_URING
+    namespace {
+        /// Minimal `io_uring` instance over raw syscalls, `liburing` is not required
+        class Ring {
+        public:
+            ~Ring() {
+                if (sqPtr) {
+                    ::munmap(sqPtr, sqSize);
+                }
+                if (cqPtr and cqPtr != sqPtr) {
+                    ::munmap(cqPtr, cqSize);
+                }
+                if (sqes) {
+                    ::munmap(sqes, sqesSize);
+                }
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+
+            /// Returns `false` if kernel does not support `io_uring` or it is disabled
+            bool setup(uint32_t entries) {
+                io_uring_params params{};
+                fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+                if (fd < 0) {
+                    return false;
+                }
+
+                sqSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+                cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+                if (singleMmap) {
+                    sqSize = cqSize = std::max(sqSize, cqSize);
+                }
+
+                sqPtr = mapRing(sqSize, IORING_OFF_SQ_RING);
+                if (not sqPtr) {
+                    return false;
+                }
+                cqPtr = singleMmap ? sqPtr : mapRing(cqSize, IORING_OFF_CQ_RING);
+                if (not cqPtr) {
+                    return false;
+                }
+                sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                sqes = static_cast<io_uring_sqe*>(mapRing(sqesSize, IORING_OFF_SQES));
+                if (not sqes) {
+                    return false;
+                }
+
+                auto * sq = static_cast<uint8_t*>(sqPtr);
+                sqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+                sqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+                sqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+                sqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+                sqEntries = params.sq_entries;
+
+                auto * cq = static_cast<uint8_t*>(cqPtr);
+                cqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+                cqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+                cqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+                cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+                return true;
+            }
+
+            uint32_t capacity() const {
+                return sqEntries;
+            }
+
+            /// Returns next free submission entry, `nullptr` if submission queue is full
+            io_uring_sqe * getSqe() {
+                const auto head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+                if (localTail - head >= sqEntries) {
+                    return nullptr;
+                }
+                const auto index = localTail & sqMask;
+                auto * sqe = &sqes[index];
+                *sqe = {};
+                sqArray[index] = index;
+                localTail++;
+                toSubmit++;
+                return sqe;
+            }
+
+            /// Submit prepared entries, wait for at least `waitFor` completions
+            bool enter(uint32_t waitFor) {
+                __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+                while (true) {
+                    const auto res = ::syscall(
+                        __NR_io_uring_enter, fd, toSubmit, waitFor, waitFor > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0
+                    );
+                    if (res >= 0) {
+                        toSubmit -= static_cast<uint32_t>(res);
+                        return true;
+                    }
+                    if (errno != EINTR) {
+                        return false;
+                    }
+                }
+            }
+
+            /// Take back prepared entries which kernel has not consumed yet, `func` is called on each of them
+            template<class F>
+            void discard(const F & func) {
+                for (auto tail = localTail - toSubmit; tail != localTail; tail++) {
+                    func(sqes[tail & sqMask]);
+                }
+                localTail -= toSubmit;
+                toSubmit = 0;
+                __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+            }
+
+            /// Call `func` on each available completion
+            template<class F>
+            void reap(const F & func) {
+                auto head = *cqHead;
+                const auto tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+                while (head != tail) {
+                    const auto cqe = cqes[head & cqMask];
+                    head++;
+                    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+                    func(cqe);
+                }
+            }
+
+        private:
+            int fd{-1};
+            void * sqPtr{nullptr};
+            size_t sqSize{0};
+            void * cqPtr{nullptr};
+            size_t cqSize{0};
+            io_uring_sqe * sqes{nullptr};
+            size_t sqesSize{0};
+
+            uint32_t * sqHead{nullptr};
+            uint32_t * sqTail{nullptr};
+            uint32_t sqMask{0};
+            uint32_t * sqArray{nullptr};
+            uint32_t sqEntries{0};
+            uint32_t localTail{0};
+            uint32_t toSubmit{0};
+
+            uint32_t * cqHead{nullptr};
+            uint32_t * cqTail{nullptr};
+            uint32_t cqMask{0};
+            io_uring_cqe * cqes{nullptr};
+
+            void * mapRing(size_t size, off_t offset) const {
+                void * ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+                return ptr == MAP_FAILED ? nullptr : ptr;
+            }
+        };
+
+        enum class UringOp : uint8_t {
+            Open,
+            Stat,
+            Close,
+        };
+
+        struct UringFile {
+            int fd{-1};
+            struct statx stx{};
+            uint8_t pending{0}; // Count of uncompleted open and stat requests
+            bool failed{false};
+            MappedFile mapping;
+        };
+
+        uint64_t userData(size_t index, UringOp op) {
+            return (static_cast<uint64_t>(index) << 2) | static_cast<uint64_t>(op);
+        }
+    }
+#endif
+
+    SourceLoader::SourceLoader(
+        vfs_ptr vfs,
+        std::vector<std_fs::path> paths,
+        size_t workers,
+        bool allowUring,
+        size_t window
+    ) : vfs(std::move(vfs)), paths(std::move(paths)), workers(std::max<size_t>(1, workers)), window(window) {
+        allowUring = allowUring and this->vfs->isDisk() and this->vfs->mapsFiles();
+        files.resize(this->paths.size());
+        ready.resize(this->paths.size(), false);
+        stats.capacity = window == 0 ? this->paths.size() : window;
+
+        thread = std::thread([this, allowUring]() {
+            if (allowUring and loadWithUring()) {
+                return;
+            }
+            chooseBackend(Backend::Threads);
+            loadWithThreads();
+        });
+    }
+
+    SourceLoader::~SourceLoader() {
+        {
+            // Files may be left untaken, window must not block loader thread then
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        windowMoved.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    SourceLoader::Backend SourceLoader::getBackend() {
+        std::unique_lock<std::mutex> lock(mutex);
+        loaded.wait(lock, [&]() {
+            return backendChosen;
+        });
+        return backend;
+    }
+
+    LoadedFile SourceLoader::take(size_t index) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (not ready.at(index)) {
+            const auto start = std::chrono::steady_clock::now();
+            loaded.wait(lock, [&]() {
+                return ready.at(index);
+            });
+            stats.consumerStallMs += std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start
+            ).count();
+        }
+        auto file = std::move(files.at(index));
+        takenCount++;
+        lock.unlock();
+        windowMoved.notify_all();
+        return file;
+    }
+
+    utils::thread::QueueStats SourceLoader::getStats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    SourceLoader::HashingStats SourceLoader::getHashingStats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return hashingStats;
+    }
+
+    std::string SourceLoader::backendToString(Backend backend) {
+        switch (backend) {
+            case Backend::Uring: return "io_uring";
+            case Backend::Threads: return "threads";
+        }
+        return "unknown";
+    }
+
+    void SourceLoader::chooseBackend(Backend chosen) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            backend = chosen;
+            backendChosen = true;
+        }
+        loaded.notify_all();
+    }
+
+    void SourceLoader::publish(size_t index, LoadedFile && file) {
+        // Contents are hot in cache (or just faulted in, for mapped file), hash them before they are handed over
+        double hashingMs = 0;
+        if (file.ok) {
+            const auto start = std::chrono::steady_clock::now();
+            file.contentHash = utils::hash::contentHash(file.view());
+            hashingMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (file.ok) {
+                hashingStats.files++;
+                hashingStats.bytes += file.view().size();
+                hashingStats.ms += hashingMs;
+            }
+            files.at(index) = std::move(file);
+            ready.at(index) = true;
+            readyCount++;
+            const auto depth = readyCount - takenCount;
+            stats.pushed++;
+            stats.depthSum += depth;
+            stats.maxDepth = std::max(stats.maxDepth, depth);
+        }
+        loaded.notify_all();
+    }
+
+    bool SourceLoader::fitsWindow(size_t index) const {
+        return stopping or window == 0 or index < takenCount + window;
+    }
+
+    void SourceLoader::waitWindow(size_t index) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (fitsWindow(index)) {
+            return;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        windowMoved.wait(lock, [&]() {
+            return fitsWindow(index);
+        });
+        stats.producerStallMs += std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+    }
+
+    void SourceLoader::loadWithThreads() {
+        utils::thread::parallelFor(workers, paths.size(), [&](size_t, size_t index) {
+            waitWindow(index);
+            auto file = vfs->read(paths.at(index));
+            if (file.ok and file.mapping) {
+                file.mapping->prefetch();
+            }
+            publish(index, std::move(file));
+        });
+    }
+
+    bool SourceLoader::loadWithUring() {
+#ifdef JACY_FS_URING
+        if (paths.empty()) {
+            // Nothing to batch
+            return false;
+        }
+
+        // Note: State is declared before the ring, so it outlives the ring and
+        //  requests cancelled on ring teardown never touch freed buffers
+        std::vector<UringFile> state(paths.size());
+        Ring ring;
+        if (not ring.setup(static_cast<uint32_t>(std::min<size_t>(64, paths.size() * 2)))) {
+            return false;
+        }
+        chooseBackend(Backend::Uring);
+
+        // Closes of already opened files go before opens of new files,
+        //  so files complete in order they are parsed and count of open descriptors stays bounded.
+        std::deque<std::pair<size_t, UringOp>> followUps;
+        size_t nextOpen = 0;
+        size_t inFlight = 0;
+        size_t done = 0;
+
+        const auto prepare = [&](size_t index, UringOp op) -> bool {
+            auto * sqe = ring.getSqe();
+            if (not sqe) {
+                return false;
+            }
+            auto & file = state.at(index);
+            sqe->user_data = userData(index, op);
+            switch (op) {
+                case UringOp::Open: {
+                    sqe->opcode = IORING_OP_OPENAT;
+                    sqe->fd = AT_FDCWD;
+                    sqe->addr = reinterpret_cast<uint64_t>(paths.at(index).c_str());
+                    sqe->open_flags = O_RDONLY | O_CLOEXEC;
+                    break;
+                }
+                case UringOp::Stat: {
+                    sqe->opcode = IORING_OP_STATX;
+                    sqe->fd = AT_FDCWD;
+                    sqe->addr = reinterpret_cast<uint64_t>(paths.at(index).c_str());
+                    sqe->len = STATX_SIZE;
+                    sqe->addr2 = reinterpret_cast<uint64_t>(&file.stx);
+                    break;
+                }
+                case UringOp::Close: {
+                    sqe->opcode = IORING_OP_CLOSE;
+                    sqe->fd = file.fd;
+                    // Descriptor is owned by the ring from now on
+                    file.fd = -1;
+                    break;
+                }
+            }
+            inFlight++;
+            return true;
+        };
+
+        const auto finish = [&](size_t index) {
+            auto & file = state.at(index);
+            LoadedFile loadedFile;
+            if (file.failed) {
+                // Request may be unsupported by older kernel, fall back to mapping the file
+                loadedFile = vfs->read(paths.at(index));
+            } else {
+                loadedFile.mapping = std::make_unique<MappedFile>(std::move(file.mapping));
+                loadedFile.ok = true;
+            }
+            file = {};
+            publish(index, std::move(loadedFile));
+            done++;
+        };
+
+        const auto closeOrFinish = [&](size_t index) {
+            if (state.at(index).fd >= 0) {
+                followUps.emplace_back(index, UringOp::Close);
+            } else {
+                finish(index);
+            }
+        };
+
+        const auto complete = [&](const io_uring_cqe & cqe) {
+            inFlight--;
+            const auto index = static_cast<size_t>(cqe.user_data >> 2);
+            const auto op = static_cast<UringOp>(cqe.user_data & 3);
+            auto & file = state.at(index);
+            switch (op) {
+                case UringOp::Open:
+                case UringOp::Stat: {
+                    if (cqe.res < 0) {
+                        file.failed = true;
+                    } else if (op == UringOp::Open) {
+                        file.fd = cqe.res;
+                    }
+                    if (--file.pending > 0) {
+                        break;
+                    }
+                    // Map the file instead of reading it, so contents are not copied into heap buffer
+                    if (not file.failed) {
+                        if (file.mapping.map(file.fd, static_cast<size_t>(file.stx.stx_size))) {
+                            file.mapping.prefetch();
+                        } else {
+                            file.failed = true;
+                        }
+                    }
+                    closeOrFinish(index);
+                    break;
+                }
+                case UringOp::Close: {
+                    finish(index);
+                    break;
+                }
+            }
+        };
+
+        while (done < paths.size()) {
+            // Leave room in completion queue, it is twice as large as submission queue
+            while (not followUps.empty() and inFlight < ring.capacity()) {
+                const auto & next = followUps.front();
+                if (not prepare(next.first, next.second)) {
+                    break;
+                }
+                followUps.pop_front();
+            }
+            if (inFlight == 0 and followUps.empty() and nextOpen < paths.size()) {
+                // Nothing to wait for in the ring, wait until parser takes files
+                waitWindow(nextOpen);
+            }
+            while (nextOpen < paths.size() and followUps.empty() and inFlight + 2 <= ring.capacity()) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (not fitsWindow(nextOpen)) {
+                        break;
+                    }
+                }
+                // Submission queue has as many entries as in-flight limit, so both requests fit
+                state.at(nextOpen).pending = 2;
+                prepare(nextOpen, UringOp::Open);
+                prepare(nextOpen, UringOp::Stat);
+                nextOpen++;
+            }
+
+            if (inFlight == 0) {
+                continue;
+            }
+
+            if (not ring.enter(1)) {
+                // Kernel refused requests. Requests it has not consumed are taken back,
+                //  submitted ones are waited for, so descriptors they open are closed below.
+                // Note: If waiting fails too, the rest is cancelled on ring teardown.
+                ring.discard([&](const io_uring_sqe & sqe) {
+                    inFlight--;
+                    if (static_cast<UringOp>(sqe.user_data & 3) == UringOp::Close) {
+                        state.at(static_cast<size_t>(sqe.user_data >> 2)).fd = sqe.fd;
+                    }
+                });
+                const auto drain = [&](const io_uring_cqe & cqe) {
+                    inFlight--;
+                    if (static_cast<UringOp>(cqe.user_data & 3) == UringOp::Open and cqe.res >= 0) {
+                        state.at(static_cast<size_t>(cqe.user_data >> 2)).fd = cqe.res;
+                    }
+                };
+                ring.reap(drain);
+                while (inFlight > 0 and ring.enter(1)) {
+                    ring.reap(drain);
+                }
+                for (auto & file : state) {
+                    if (file.fd >= 0) {
+                        ::close(file.fd);
+                        file.fd = -1;
+                    }
+                }
+
+                // Map remaining files directly
+                for (size_t index = 0; index < paths.size(); index++) {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    if (ready.at(index)) {
+                        continue;
+                    }
+                    lock.unlock();
+                    waitWindow(index);
+                    publish(index, vfs->read(paths.at(index)));
+                }
+                return true;
+            }
+            ring.reap(complete);
+        }
+
+        return true;
+#else
+        return false;
+#endif
+    }
+}
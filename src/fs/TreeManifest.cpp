@@ -0,0 +1,333 @@
+#include "fs/TreeManifest.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <deque>
+
+#include "fs/MappedFile.h"
+#include "fs/fs.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JACY_FS_POSIX_STAT 1
+#include <sys/stat.h>
+#endif
+
+namespace jc::fs {
+    namespace {
+        template<class T>
+        void appendRaw(std::string & buffer, const T & value) {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void appendStr(std::string & buffer, const std::string & str) {
+            appendRaw(buffer, static_cast<uint32_t>(str.size()));
+            buffer += str;
+        }
+
+        /// Current time in units of `FileStat::mtime`.
+        /// One second is subtracted, as file timestamps may be coarser than the clock or lag behind it.
+        int64_t walkTime() {
+#ifdef JACY_FS_POSIX_STAT
+            const auto now = std::chrono::system_clock::now().time_since_epoch();
+#else
+            const auto now = std_fs::file_time_type::clock::now().time_since_epoch();
+#endif
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(now - std::chrono::seconds(1)).count();
+        }
+
+        /// Bounds-checked sequential reader over mapped manifest
+        struct ManifestReader {
+            const uint8_t * data;
+            size_t size;
+            size_t offset{0};
+            bool failed{false};
+
+            template<class T>
+            T read() {
+                T value{};
+                if (offset + sizeof(T) > size) {
+                    failed = true;
+                    return value;
+                }
+                std::memcpy(&value, data + offset, sizeof(T));
+                offset += sizeof(T);
+                return value;
+            }
+
+            std::string readStr() {
+                const auto len = read<uint32_t>();
+                if (failed or offset + len > size) {
+                    failed = true;
+                    return "";
+                }
+                std::string str(reinterpret_cast<const char*>(data + offset), len);
+                offset += len;
+                return str;
+            }
+        };
+    }
+
+    bool TreeManifest::load(
+        const std_fs::path & path,
+        const std_fs::path & root,
+        const std::string & allowedExt,
+        const std::string & filterKey
+    ) {
+        dirs.clear();
+        files.clear();
+
+        MappedFile file;
+        if (not file.open(path)) {
+            return false;
+        }
+
+        ManifestReader reader{file.data(), file.size()};
+        const auto magic = reader.read<uint32_t>();
+        const auto version = reader.read<uint32_t>();
+        if (reader.failed or magic != MAGIC or version != VERSION) {
+            return false;
+        }
+        // Manifest of another walk describes different set of entries
+        const auto & walkRoot = reader.readStr();
+        const auto & walkExt = reader.readStr();
+        const auto & walkFilterKey = reader.readStr();
+        const auto recordedWalkStart = reader.read<int64_t>();
+        const auto & normalRoot = normalizeDir(root);
+        if (
+            reader.failed or walkRoot != normalRoot.string() or walkExt != allowedExt or walkFilterKey != filterKey
+        ) {
+            return false;
+        }
+
+        const auto dirsCount = reader.read<uint32_t>();
+        const auto filesCount = reader.read<uint32_t>();
+        std::vector<std::string> dirPaths;
+        for (uint32_t i = 0; i < dirsCount and not reader.failed; i++) {
+            const auto parent = reader.read<uint32_t>();
+            const auto mtime = reader.read<int64_t>();
+            auto dirPath = reader.readStr();
+            if (parent != NO_PARENT) {
+                if (parent >= dirPaths.size()) {
+                    reader.failed = true;
+                    break;
+                }
+                dirs[dirPaths.at(parent)].listing.subdirs.emplace_back(dirPath);
+            }
+            dirs[dirPath].mtime = mtime;
+            dirPaths.emplace_back(std::move(dirPath));
+        }
+        for (uint32_t i = 0; i < filesCount and not reader.failed; i++) {
+            const auto parent = reader.read<uint32_t>();
+            FileRecord record;
+            record.stat.mtime = reader.read<int64_t>();
+            record.stat.size = reader.read<uint64_t>();
+            const auto hashed = reader.read<uint8_t>();
+            utils::hash::Hash128 hash;
+            hash.low = reader.read<uint64_t>();
+            hash.high = reader.read<uint64_t>();
+            if (hashed) {
+                record.hash = hash;
+            }
+            auto filePath = reader.readStr();
+            if (parent >= dirPaths.size()) {
+                reader.failed = true;
+                break;
+            }
+            dirs[dirPaths.at(parent)].listing.files.emplace_back(filePath);
+            files.emplace(std::move(filePath), std::move(record));
+        }
+
+        if (reader.failed) {
+            dirs.clear();
+            files.clear();
+            return false;
+        }
+        this->root = normalRoot;
+        this->allowedExt = allowedExt;
+        this->filterKey = filterKey;
+        walkStart = recordedWalkStart;
+        return true;
+    }
+
+    bool TreeManifest::save(const std_fs::path & path) const {
+        std::string data;
+        appendRaw(data, MAGIC);
+        appendRaw(data, VERSION);
+        appendStr(data, root.string());
+        appendStr(data, allowedExt);
+        appendStr(data, filterKey);
+        appendRaw(data, walkStart);
+
+        // Directories go in breadth-first order, so parent is always written before its entries
+        std::vector<std::pair<uint32_t, std::string>> dirRecords;
+        std::unordered_map<std::string, uint32_t> dirIndices;
+        std::deque<std::pair<uint32_t, std::string>> queue;
+        if (dirs.find(root.string()) != dirs.end()) {
+            queue.emplace_back(NO_PARENT, root.string());
+        }
+        while (not queue.empty()) {
+            auto next = std::move(queue.front());
+            queue.pop_front();
+            const auto & dir = dirs.find(next.second);
+            if (dir == dirs.end()) {
+                continue;
+            }
+            const auto index = static_cast<uint32_t>(dirRecords.size());
+            dirIndices.emplace(next.second, index);
+            for (const auto & subdir : dir->second.listing.subdirs) {
+                queue.emplace_back(index, subdir.string());
+            }
+            dirRecords.emplace_back(std::move(next));
+        }
+
+        size_t filesCount = 0;
+        std::string fileData;
+        for (const auto & dirRecord : dirRecords) {
+            const auto & dir = dirs.at(dirRecord.second);
+            for (const auto & filePath : dir.listing.files) {
+                const auto & file = files.find(filePath.string());
+                if (file == files.end()) {
+                    continue;
+                }
+                const auto & record = file->second;
+                appendRaw(fileData, dirIndices.at(dirRecord.second));
+                appendRaw(fileData, record.stat.mtime);
+                appendRaw(fileData, record.stat.size);
+                appendRaw(fileData, static_cast<uint8_t>(record.hash ? 1 : 0));
+                const auto hash = record.hash ? record.hash.unwrap() : utils::hash::Hash128{};
+                appendRaw(fileData, hash.low);
+                appendRaw(fileData, hash.high);
+                appendStr(fileData, filePath.string());
+                filesCount++;
+            }
+        }
+
+        appendRaw(data, static_cast<uint32_t>(dirRecords.size()));
+        appendRaw(data, static_cast<uint32_t>(filesCount));
+        for (const auto & dirRecord : dirRecords) {
+            appendRaw(data, dirRecord.first);
+            appendRaw(data, dirs.at(dirRecord.second).mtime);
+            appendStr(data, dirRecord.second);
+        }
+        data += fileData;
+
+        // Write to temporary file and rename, so concurrent compiler never reads partial manifest
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            if (not file.is_open()) {
+                return false;
+            }
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (not file.good()) {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std_fs::rename(tmpPath, path, ec);
+        return not ec;
+    }
+
+    dt::Option<FileStat> TreeManifest::stat(const std_fs::path & path) {
+#ifdef JACY_FS_POSIX_STAT
+        struct stat st{};
+        if (::stat(path.c_str(), &st) != 0) {
+            return dt::None;
+        }
+#ifdef __APPLE__
+        const auto & mtime = st.st_mtimespec;
+#else
+        const auto & mtime = st.st_mtim;
+#endif
+        return FileStat{
+            static_cast<int64_t>(mtime.tv_sec) * 1000000000 + static_cast<int64_t>(mtime.tv_nsec),
+            static_cast<uint64_t>(st.st_size),
+        };
+#else
+        std::error_code ec;
+        const auto time = std_fs::last_write_time(path, ec);
+        if (ec) {
+            return dt::None;
+        }
+        const auto size = std_fs::is_directory(path, ec) ? 0 : std_fs::file_size(path, ec);
+        return FileStat{
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count(),
+            static_cast<uint64_t>(size),
+        };
+#endif
+    }
+
+    void TreeManifest::beginWalk(const std_fs::path & root, const std::string & allowedExt, const std::string & filterKey) {
+        // Root is recorded as by the walk, see `fs::normalizeDir`
+        const auto & normalRoot = normalizeDir(root);
+        if (normalRoot != this->root or allowedExt != this->allowedExt or filterKey != this->filterKey) {
+            dirs.clear();
+            files.clear();
+        }
+        this->root = normalRoot;
+        this->allowedExt = allowedExt;
+        this->filterKey = filterKey;
+        prevWalkStart = walkStart;
+        walkStart = walkTime();
+        prevDirs = std::move(dirs);
+        prevFiles = std::move(files);
+        dirs.clear();
+        files.clear();
+        stats = {};
+    }
+
+    void TreeManifest::endWalk() {
+        prevDirs.clear();
+        prevFiles.clear();
+    }
+
+    const TreeManifest::Listing * TreeManifest::findListing(const std_fs::path & dir, int64_t mtime) const {
+        const auto & found = prevDirs.find(dir.string());
+        if (found == prevDirs.end() or found->second.mtime != mtime or mtime >= prevWalkStart) {
+            return nullptr;
+        }
+        return &found->second.listing;
+    }
+
+    void TreeManifest::setDir(const std_fs::path & dir, int64_t mtime, Listing && listing, bool reused) {
+        if (reused) {
+            stats.dirsReused++;
+        } else {
+            stats.dirsListed++;
+        }
+        auto & record = dirs[dir.string()];
+        record.mtime = mtime;
+        record.listing = std::move(listing);
+    }
+
+    void TreeManifest::setFile(const std_fs::path & file, const FileStat & stat) {
+        stats.files++;
+        FileRecord record;
+        record.stat = stat;
+        const auto & prev = prevFiles.find(file.string());
+        if (prev != prevFiles.end() and prev->second.stat == stat and stat.mtime < prevWalkStart) {
+            record.hash = prev->second.hash;
+        } else {
+            stats.filesChanged++;
+        }
+        files[file.string()] = std::move(record);
+    }
+
+    dt::Option<utils::hash::Hash128> TreeManifest::getHash(const std_fs::path & file) const {
+        // Entries are recorded by normalized paths of walk, e.g. root file may be given as `./main.jc`
+        const auto & found = files.find(file.lexically_normal().string());
+        if (found == files.end()) {
+            return dt::None;
+        }
+        return found->second.hash;
+    }
+
+    void TreeManifest::setHash(const std_fs::path & file, const utils::hash::Hash128 & hash) {
+        const auto & found = files.find(file.lexically_normal().string());
+        if (found != files.end()) {
+            found->second.hash = hash;
+        }
+    }
+}
@@ -0,0 +1,197 @@
+#include "fs/Vfs.h"
+
+#include <fstream>
+#include <iterator>
+
+namespace jc::fs {
+    namespace {
+        size_t pathDepth(const std_fs::path & path) {
+            return static_cast<size_t>(std::distance(path.begin(), path.end()));
+        }
+
+        /// Element of `path` at `index`, end iterator if `path` is shorter
+        std_fs::path::iterator pathElement(const std_fs::path & path, size_t index) {
+            auto element = path.begin();
+            for (size_t i = 0; i < index and element != path.end(); i++) {
+                element++;
+            }
+            return element;
+        }
+
+        bool hasPrefix(const std_fs::path & path, const std_fs::path & prefix) {
+            auto element = path.begin();
+            for (const auto & prefixElement : prefix) {
+                if (element == path.end() or *element != prefixElement) {
+                    return false;
+                }
+                element++;
+            }
+            return true;
+        }
+    }
+
+    // DiskVfs //
+    entry_ptr DiskVfs::fileEntry(const std_fs::path & path) const {
+        return fs::fileEntry(path);
+    }
+
+    entry_ptr DiskVfs::readDirRec(
+        const std_fs::path & path,
+        const std::string & allowedExt,
+        size_t workers,
+        const PathFilter * filter,
+        TreeManifest * manifest
+    ) const {
+        return fs::readDirRec(path, allowedExt, workers, filter, manifest);
+    }
+
+    LoadedFile DiskVfs::read(const std_fs::path & path) const {
+        LoadedFile file;
+        if (not mapFiles) {
+            std::ifstream stream(path, std::ios::binary);
+            if (stream.is_open()) {
+                file.contents = std::make_shared<const std::string>(
+                    std::istreambuf_iterator<char>(stream),
+                    std::istreambuf_iterator<char>()
+                );
+                file.ok = not stream.bad();
+            }
+            return file;
+        }
+        file.mapping = std::make_unique<MappedFile>();
+        file.ok = file.mapping->open(path);
+        return file;
+    }
+
+    // MemoryVfs //
+    void MemoryVfs::addFile(const std_fs::path & path, std::string contents) {
+        files[normalize(path)] = std::make_shared<const std::string>(std::move(contents));
+    }
+
+    std::shared_ptr<MemoryVfs> MemoryVfs::fromDisk(const std_fs::path & dir, const std::string & allowedExt) {
+        auto vfs = std::make_shared<MemoryVfs>();
+        const auto root = normalize(dir);
+        std::error_code ec;
+        for (auto it = std_fs::recursive_directory_iterator(root, ec); not ec and it != std_fs::end(it); it.increment(ec)) {
+            const auto & name = it->path().filename().string();
+            if (it->is_directory(ec)) {
+                if (not name.empty() and name.front() == '.') {
+                    it.disable_recursion_pending();
+                }
+                continue;
+            }
+            if (not it->is_regular_file(ec) or (not allowedExt.empty() and it->path().extension() != allowedExt)) {
+                continue;
+            }
+            MappedFile file;
+            if (file.open(it->path())) {
+                vfs->addFile(it->path(), std::string(reinterpret_cast<const char*>(file.data()), file.size()));
+            }
+        }
+
+        MappedFile ignoreFile;
+        if (ignoreFile.open(root / PathFilter::IGNORE_FILE)) {
+            vfs->addFile(
+                root / PathFilter::IGNORE_FILE,
+                std::string(reinterpret_cast<const char*>(ignoreFile.data()), ignoreFile.size())
+            );
+        }
+        return vfs;
+    }
+
+    entry_ptr MemoryVfs::fileEntry(const std_fs::path & path) const {
+        if (files.find(normalize(path)) == files.end()) {
+            common::Logger::devPanic("Called `MemoryVfs::fileEntry` with non-existent file");
+        }
+        return std::make_shared<Entry>(path);
+    }
+
+    entry_ptr MemoryVfs::readDirRec(
+        const std_fs::path & path,
+        const std::string & allowedExt,
+        size_t,
+        const PathFilter * filter,
+        TreeManifest*
+    ) const {
+        const auto dir = normalize(path);
+        if (dir == ".") {
+            // Every relative path is inside current directory
+            return buildDir(dir, 0, files.begin(), files.end(), allowedExt, filter);
+        }
+        const auto first = files.lower_bound(dir);
+        auto last = first;
+        while (last != files.end() and hasPrefix(last->first, dir)) {
+            last++;
+        }
+        return buildDir(dir, pathDepth(dir), first, last, allowedExt, filter);
+    }
+
+    LoadedFile MemoryVfs::read(const std_fs::path & path) const {
+        LoadedFile file;
+        const auto & found = files.find(normalize(path));
+        if (found != files.end()) {
+            file.contents = found->second;
+            file.ok = true;
+        }
+        return file;
+    }
+
+    std_fs::path MemoryVfs::normalize(const std_fs::path & path) {
+        const auto & normal = path.lexically_normal();
+        return normal.empty() ? std_fs::path(".") : normal;
+    }
+
+    entry_ptr MemoryVfs::buildDir(
+        const std_fs::path & dir,
+        size_t depth,
+        file_map::const_iterator first,
+        file_map::const_iterator last,
+        const std::string & allowedExt,
+        const PathFilter * filter
+    ) {
+        // Paths of entries are built as by disk walk: `(dir / name).lexically_normal()`
+        entry_list subdirs;
+        std::vector<std_fs::path> dirFiles;
+        for (auto it = first; it != last;) {
+            const auto & filePath = it->first;
+            const auto name = pathElement(filePath, depth);
+            if (name == filePath.end() or (depth == 0 and (filePath.has_root_path() or *name == ".."))) {
+                // Not inside current directory
+                it++;
+                continue;
+            }
+            const auto entryPath = (dir / *name).lexically_normal();
+            if (std::next(name) == filePath.end()) {
+                if (
+                    (allowedExt.empty() or entryPath.extension() == allowedExt)
+                    and (not filter or not filter->excludesFile(entryPath))
+                ) {
+                    dirFiles.push_back(entryPath);
+                }
+                it++;
+                continue;
+            }
+
+            // Files of subdirectory follow each other
+            auto subdirLast = std::next(it);
+            while (subdirLast != last) {
+                const auto subdirName = pathElement(subdirLast->first, depth);
+                if (subdirName == subdirLast->first.end() or *subdirName != *name) {
+                    break;
+                }
+                subdirLast++;
+            }
+            if (not filter or not filter->excludesDir(entryPath)) {
+                subdirs.emplace_back(buildDir(entryPath, depth + 1, it, subdirLast, allowedExt, filter));
+            }
+            it = subdirLast;
+        }
+
+        entry_list entries = std::move(subdirs);
+        entries.reserve(entries.size() + dirFiles.size());
+        for (const auto & file : dirFiles) {
+            entries.emplace_back(std::make_shared<Entry>(file));
+        }
+        return std::make_shared<Entry>(dir, std::move(entries));
+    }
+}
@@ -0,0 +1,134 @@
+#include "fs/Watcher.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#include "fs/fs.h"
+
+#if defined(__linux__)
+#define JACY_FS_INOTIFY 1
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace jc::fs {
+    namespace {
+        bool isHidden(const std_fs::path & path) {
+            const auto & name = path.filename().string();
+            return not name.empty() and name.front() == '.' and name != "." and name != "..";
+        }
+    }
+
+    Watcher::Watcher(const std_fs::path & root, const std::string & allowedExt)
+        : root(normalizeDir(root)), allowedExt(allowedExt) {
+#ifdef JACY_FS_INOTIFY
+        fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        addWatchRec(this->root);
+#endif
+    }
+
+    Watcher::~Watcher() {
+#ifdef JACY_FS_INOTIFY
+        if (fd >= 0) {
+            ::close(fd);
+        }
+#endif
+    }
+
+    std::vector<std_fs::path> Watcher::wait(std::chrono::milliseconds debounce) {
+        std::vector<std_fs::path> changed;
+        if (not isOpen()) {
+            return changed;
+        }
+
+        while (changed.empty()) {
+            if (not readEvents(changed, -1)) {
+                return changed;
+            }
+        }
+        while (readEvents(changed, static_cast<int>(debounce.count()))) {}
+
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+        return changed;
+    }
+
+    void Watcher::addWatchRec(const std_fs::path & dir) {
+#ifdef JACY_FS_INOTIFY
+        const auto mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+        const int wd = ::inotify_add_watch(fd, dir.c_str(), mask);
+        if (wd < 0) {
+            log.warn("Failed to watch directory", dir);
+            return;
+        }
+        watches[wd] = dir;
+
+        std::error_code ec;
+        for (const auto & entry : std_fs::directory_iterator(dir, ec)) {
+            if (entry.is_directory(ec) and not isHidden(entry.path())) {
+                addWatchRec((dir / entry.path().filename()).lexically_normal());
+            }
+        }
+#endif
+    }
+
+    bool Watcher::readEvents(std::vector<std_fs::path> & changed, int timeoutMs) {
+#ifdef JACY_FS_INOTIFY
+        pollfd pfd{fd, POLLIN, 0};
+        const int ready = ::poll(&pfd, 1, timeoutMs);
+        if (ready < 0) {
+            return errno == EINTR;
+        }
+        if (ready == 0) {
+            return false;
+        }
+
+        alignas(inotify_event) char buffer[4096];
+        while (true) {
+            const auto len = ::read(fd, buffer, sizeof(buffer));
+            if (len <= 0) {
+                break;
+            }
+            for (ssize_t offset = 0; offset < len;) {
+                const auto * event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    // Events are lost, so any file may be changed and new directories may be not watched yet
+                    addWatchRec(root);
+                    changed.push_back(root);
+                    continue;
+                }
+                if (event->mask & IN_IGNORED) {
+                    watches.erase(event->wd);
+                    continue;
+                }
+                const auto & dir = watches.find(event->wd);
+                if (dir == watches.end() or event->len == 0) {
+                    continue;
+                }
+
+                const auto path = (dir->second / event->name).lexically_normal();
+                if (isHidden(path)) {
+                    continue;
+                }
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        addWatchRec(path);
+                    }
+                    changed.push_back(path);
+                } else if (allowedExt.empty() or path.extension() == allowedExt) {
+                    changed.push_back(path);
+                }
+            }
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+}
@@ -1,50 +1,164 @@
 #include "fs/fs.h"
 
+#include "fs/TreeManifest.h"
+#include "fs/PathFilter.h"
+
 namespace jc::fs {
     bool exists(const std_fs::path & path) {
         return std_fs::exists(std_fs::relative(path));
     }
 
-    entry_ptr readfile(const std_fs::path & path) {
-        if (not fs::exists(path)) {
-            common::Logger::devPanic("Called `fs::readfile` with non-existent file");
+    std_fs::path normalizeDir(const std_fs::path & path) {
+        auto normal = path.lexically_normal();
+        if (not normal.has_filename() and normal.has_relative_path()) {
+            normal = normal.parent_path();
         }
+        return normal.empty() ? std_fs::path(".") : normal;
+    }
 
-        const auto & entry = std_fs::directory_entry(path);
-        std::fstream file(path);
-
-        if (!file.is_open()) {
-            common::Logger::devPanic("File " + path.string() + " not found");
+    bool isInsideDir(const std_fs::path & path, const std_fs::path & dir) {
+        if (dir == ".") {
+            return path.is_relative() and not path.empty() and *path.begin() != "..";
+        }
+        auto element = path.begin();
+        for (const auto & dirElement : dir) {
+            if (element == path.end() or *element != dirElement) {
+                return false;
+            }
+            element++;
         }
+        return element != path.end();
+    }
 
-        std::stringstream ss;
-        ss << file.rdbuf();
-        auto data = ss.str();
-        file.close();
+    entry_ptr fileEntry(const std_fs::path & path) {
+        if (not fs::exists(path)) {
+            common::Logger::devPanic("Called `fs::fileEntry` with non-existent file");
+        }
+        return std::make_shared<Entry>(path);
+    }
 
-        return std::make_shared<Entry>(path, std::move(data));
+    entry_list readdirRecEntries(
+        const std_fs::path & path,
+        const std::string & allowedExt,
+        size_t workers,
+        const PathFilter * filter
+    ) {
+        return readDirRec(path, allowedExt, workers, filter)->getSubModules();
     }
 
-    entry_list readdirRecEntries(const std_fs::path & path, const std::string & allowedExt) {
-        entry_list entries;
-        for (const auto & entry : std_fs::directory_iterator(path)) {
-            const auto & entryPath = std_fs::relative(entry.path());
-            if (entry.is_directory()) {
-                entries.emplace_back(
-                    std::make_shared<Entry>(entryPath, std::move(readdirRecEntries(entryPath)))
-                );
-            } else if (entry.is_regular_file()) {
-                if (entryPath.extension() != allowedExt) {
-                    continue;
+    entry_ptr readDirRec(
+        const std_fs::path & path,
+        const std::string & allowedExt,
+        size_t workers,
+        const PathFilter * filter,
+        TreeManifest * manifest
+    ) {
+        // Directories are walked level by level, directories of one level are listed in parallel.
+        // Subdirectories of a directory always get greater indices, so entries are built bottom-up in reverse order.
+        struct DirNode {
+            explicit DirNode(std_fs::path path) : path(std::move(path)) {}
+
+            std_fs::path path;
+            std::vector<std_fs::path> files;
+            std::vector<std_fs::path> subdirPaths;
+            std::vector<size_t> subdirs;
+
+            // Metadata recorded to manifest
+            bool statted{false};
+            bool reused{false};
+            int64_t mtime{0};
+            std::vector<FileStat> fileStats;
+        };
+
+        std::vector<DirNode> dirs;
+        dirs.emplace_back(normalizeDir(path));
+
+        size_t levelBegin = 0;
+        while (levelBegin < dirs.size()) {
+            const size_t levelEnd = dirs.size();
+            utils::thread::parallelFor(workers, levelEnd - levelBegin, [&](size_t, size_t task) {
+                auto & dir = dirs.at(levelBegin + task);
+                if (manifest) {
+                    const auto & dirStat = TreeManifest::stat(dir.path);
+                    if (dirStat) {
+                        dir.statted = true;
+                        dir.mtime = dirStat.unwrap().mtime;
+                        const auto * listing = manifest->findListing(dir.path, dir.mtime);
+                        if (listing) {
+                            dir.files = listing->files;
+                            dir.subdirPaths = listing->subdirs;
+                            dir.reused = true;
+                        }
+                    }
+                }
+
+                if (not dir.reused) {
+                    std::error_code ec;
+                    for (const auto & entry : std_fs::directory_iterator(dir.path, ec)) {
+                        // Note: Paths are built lexically from the root path, no syscalls per entry
+                        auto entryPath = (dir.path / entry.path().filename()).lexically_normal();
+                        if (entry.is_directory(ec)) {
+                            // Excluded directory is never opened
+                            if (not filter or not filter->excludesDir(entryPath)) {
+                                dir.subdirPaths.emplace_back(std::move(entryPath));
+                            }
+                        } else if (entry.is_regular_file(ec)) {
+                            // Extension is checked before anything is read from file
+                            if (allowedExt.empty() or entryPath.extension() == allowedExt) {
+                                if (not filter or not filter->excludesFile(entryPath)) {
+                                    dir.files.emplace_back(std::move(entryPath));
+                                }
+                            }
+                        }
+                    }
+                    // Directory iteration order is unspecified, sort to keep modules order stable
+                    std::sort(dir.files.begin(), dir.files.end());
+                    std::sort(dir.subdirPaths.begin(), dir.subdirPaths.end());
+                }
+
+                if (manifest and dir.statted) {
+                    // File removed after listing is dropped, as it would be missed by listing
+                    std::vector<std_fs::path> existing;
+                    existing.reserve(dir.files.size());
+                    for (auto & file : dir.files) {
+                        const auto & fileStat = TreeManifest::stat(file);
+                        if (fileStat) {
+                            dir.fileStats.push_back(fileStat.unwrap());
+                            existing.emplace_back(std::move(file));
+                        }
+                    }
+                    dir.files = std::move(existing);
                 }
+            });
 
-                entries.emplace_back(readfile(entryPath));
+            for (size_t i = levelBegin; i < levelEnd; i++) {
+                auto & dir = dirs.at(i);
+                if (manifest and dir.statted) {
+                    for (size_t fileIndex = 0; fileIndex < dir.files.size(); fileIndex++) {
+                        manifest->setFile(dir.files.at(fileIndex), dir.fileStats.at(fileIndex));
+                    }
+                    manifest->setDir(dir.path, dir.mtime, {dir.files, dir.subdirPaths}, dir.reused);
+                }
+                for (auto & subdirPath : dirs.at(i).subdirPaths) {
+                    dirs.at(i).subdirs.push_back(dirs.size());
+                    dirs.emplace_back(std::move(subdirPath));
+                }
             }
+            levelBegin = levelEnd;
         }
-        return entries;
-    }
 
-    entry_ptr readDirRec(const std_fs::path & path, const std::string & allowedExt) {
-        return std::make_shared<Entry>(path, readdirRecEntries(path, allowedExt));
+        std::vector<entry_ptr> built(dirs.size());
+        for (size_t i = dirs.size(); i-- > 0;) {
+            entry_list entries;
+            entries.reserve(dirs.at(i).subdirs.size() + dirs.at(i).files.size());
+            for (const auto subdir : dirs.at(i).subdirs) {
+                entries.emplace_back(std::move(built.at(subdir)));
+            }
+            for (const auto & file : dirs.at(i).files) {
+                entries.emplace_back(std::make_shared<Entry>(file));
+            }
+            built.at(i) = std::make_shared<Entry>(dirs.at(i).path, std::move(entries));
+        }
+        return built.at(0);
     }
-}
\ No newline at end of file
+}
@@ -5,7 +5,7 @@ namespace jc::parser {
 
     void Lexer::addToken(Token && t, span::span_len_t len) {
         t.span = span::Span(
-            tokenLoc.line,
+            static_cast<span::span_pos_t>(tokenStartIndex),
             len,
             parseSess->fileId
         );
@@ -105,7 +105,7 @@ namespace jc::parser {
     }
 
     bool Lexer::isIdFirst(char c) {
-        return isAlpha(c) || isDigit(c);
+        return isAlpha(c) || isDigit(c) || c == '_';
     }
 
     bool Lexer::isIdPart() {
@@ -211,7 +211,7 @@ namespace jc::parser {
 
         const auto kw = Token::keywords.find(id);
         if (kw != Token::keywords.end()) {
-            addToken(kw->second, kw->first.size());
+            addToken(kw->second, static_cast<span::span_len_t>(kw->first.size()));
         } else {
             addToken(TokenKind::Id, id);
         }
@@ -523,12 +523,18 @@ namespace jc::parser {
 
     //
 
-    token_list Lexer::lex(const parse_sess_ptr & parseSess, std::string source) {
+    token_list Lexer::lex(const parse_sess_ptr & parseSess, std::string_view source) {
         this->parseSess = parseSess;
-        this->source = std::move(source);
+        this->source = source;
+
+        // Lexer is reused for each file in party
+        tokens.clear();
+        index = 0;
+        loc = {};
 
         while (!eof()) {
             tokenLoc = loc;
+            tokenStartIndex = index;
             if (hidden()) {
                 advance();
             } else if (isNL()) {
@@ -546,6 +552,7 @@ namespace jc::parser {
         }
 
         tokenLoc = loc;
+        tokenStartIndex = index;
         addToken(TokenKind::Eof, 1);
 
         return std::move(tokens);
@@ -96,12 +96,18 @@ namespace jc::parser {
 
     void Parser::skipSemi(bool optional, bool) {
         // TODO: Useless semi sugg
-        // Note: Order matters -- we use virtual semi first
-        if (not useVirtualSemi() and not isSemis() and !optional) {
+        // Note: Order matters -- we use virtual semi first.
+        //  Virtual semi does not exist in token list, but real semi may still follow it (e.g. `while ... {};`)
+        //  Closing `}` ends the last statement in block, so it does not require semi
+        const auto usedVirtualSemi = useVirtualSemi();
+        if (is(TokenKind::Semi)) {
+            advance();
+        } else if (not usedVirtualSemi and not isNL() and not is(TokenKind::RBrace) and !optional) {
             suggestErrorMsg("`;` or new-line expected", prev().span);
             return;
         }
-        advance();
+        // New-lines after `;` are semis too, leaving them leads to parsing of empty statements
+        skipNLs(true);
     }
 
     opt_token Parser::skip(
@@ -206,6 +212,10 @@ namespace jc::parser {
         this->sess = sess;
         this->parseSess = parseSess;
         this->tokens = tokens;
+        index = 0;
+        virtualSemi = false;
+        nestingDepth = 0;
+        maxNesting = common::Config::getInstance().getMaxNesting();
 
         auto begin = cspan();
         auto items = parseItemList("Unexpected expression on top-level", TokenKind::Eof);
@@ -771,13 +781,22 @@ namespace jc::parser {
             case TokenKind::For: {
                 return parseForStmt();
             }
+            case TokenKind::Val:
+            case TokenKind::Var:
+            case TokenKind::Const: {
+                auto varStmt = parseVarStmt();
+                skipSemi(false);
+                return varStmt;
+            }
             default: {
                 auto item = parseOptItem();
                 if (item) {
                     return makeStmt<ItemStmt>(item.unwrap(), begin.to(cspan()));
                 }
 
-                auto expr = parseOptExpr();
+                auto expr = utils::stack::ensureSufficient([&]() {
+                    return parseOptExpr();
+                });
                 if (!expr) {
                     // FIXME: Maybe useless due to check inside `parseExpr`
                     suggest(std::make_unique<ParseErrSugg>("Unexpected token", cspan()));
@@ -843,7 +862,7 @@ namespace jc::parser {
         }
 
         return makeStmt<VarStmt>(
-            std::move(kind), std::move(name), std::move(type.unwrap()), std::move(assignExpr), begin.to(cspan())
+            std::move(kind), std::move(name), std::move(type), std::move(assignExpr), begin.to(cspan())
         );
     }
 
@@ -868,6 +887,11 @@ namespace jc::parser {
         logParse("[opt] Expr");
 
         const auto & begin = cspan();
+
+        const NestingGuard nesting(nestingDepth);
+        if (nestingDepth > maxNesting) {
+            return Some(recoverTooDeepNesting());
+        }
         if (skipOpt(TokenKind::Return)) {
             logParse("ReturnExpr");
 
@@ -967,7 +991,9 @@ namespace jc::parser {
         logParse("Expr");
 
         const auto & begin = cspan();
-        auto expr = parseOptExpr();
+        auto expr = utils::stack::ensureSufficient([&]() {
+            return parseOptExpr();
+        });
         // We cannot unwrap, because it's just a suggestion error, so the AST will be ill-formed
         if (!expr) {
             suggestErrorMsg(suggMsg, begin);
@@ -1048,7 +1074,7 @@ namespace jc::parser {
         logParse("Assignment");
 
         const auto & begin = cspan();
-        auto lhs = precParse(0);
+        auto lhs = precParse();
 
         if (!lhs) {
             return dt::None;
@@ -1072,81 +1098,91 @@ namespace jc::parser {
         return lhs;
     }
 
-    opt_expr_ptr Parser::precParse(uint8_t index) {
-        //        logParse("precParse:" + std::to_string(index));
+    opt_expr_ptr Parser::precParse() {
+        // Iterative precedence climbing over `precTable` levels.
+        // Each stack frame is an operator waiting for its right-hand side,
+        //  so long operator chains don't consume native stack.
+        // `ceiling` is the lowest level operator allowed to continue current operand.
 
-        if (precTable.size() == index) {
-            return prefix();
-        } else if (index > precTable.size()) {
-            common::Logger::devPanic(
-                "`precParse` with index > precTable.size, index =", static_cast<int>(index),
-                "precTable.size =", precTable.size()
-            );
-        }
-
-        const auto & parser = precTable.at(index);
-        const auto flags = parser.flags;
-        const auto multiple = (flags >> 3) & 1;
-        const auto rightAssoc = (flags >> 2) & 1;
-        const auto skipLeftNLs = (flags >> 1) & 1;
-        const auto skipRightNLs = flags & 1;
+        std::vector<PrecFrame> stack;
 
         auto begin = cspan();
-        opt_expr_ptr maybeLhs = precParse(index + 1);
+        auto maybeLhs = prefix();
+        if (!maybeLhs) {
+            return dt::None;
+        }
+
+        bool skippedLeftNls = false;
         while (!eof()) {
-            bool skippedLeftNls = false;
-            if (skipLeftNLs) {
-                skippedLeftNls = skipNLs(true);
+            if (skipNLs(true)) {
+                skippedLeftNls = true;
             }
 
-            dt::Option<Token> maybeOp;
-            for (const auto & op : parser.ops) {
-                if (is(op)) {
-                    maybeOp = peek();
+            const auto ceiling = stack.empty() ? 0 : stack.back().ceiling;
+            dt::Option<uint8_t> maybeLevel;
+            for (auto level = static_cast<uint8_t>(precTable.size()); level-- > ceiling;) {
+                if (is(precTable.at(level).ops)) {
+                    maybeLevel = level;
                     break;
                 }
             }
 
-            // TODO: Add `..rhs`, `..=rhs`, `..` and `lhs..` ranges
-
-            if (!maybeOp) {
-                if (skippedLeftNls) {
-                    // Recover NL semis
-                    emitVirtualSemi();
-                }
-
-                if (maybeLhs) {
-                    return maybeLhs.unwrap("`precParse` -> !maybeOp -> `single`");
+            if (!maybeLevel) {
+                if (stack.empty()) {
+                    if (skippedLeftNls) {
+                        // Recover NL semis
+                        emitVirtualSemi();
+                    }
+                    break;
                 }
-            }
 
-            if (!maybeLhs) {
-                // TODO: Prefix range operators
-                // Left-hand side is none, and there's no range operator
-                return dt::None; // FIXME: CHECK FOR PREFIX
+                // Right-hand side of the top operator is done, fold it and check for operators of lower levels
+                auto frame = std::move(stack.back());
+                stack.pop_back();
+                maybeLhs = makeExpr<Infix>(
+                    std::move(frame.lhs), frame.op, maybeLhs.unwrap(), frame.begin.to(cspan())
+                );
+                begin = frame.begin;
+                continue;
             }
 
-            auto lhs = maybeLhs.unwrap("precParse -> maybeLhs");
+            const auto level = maybeLevel.unwrap();
+            const auto flags = precTable.at(level).flags;
+            const auto rightAssoc = (flags >> 2) & 1;
+            const auto skipRightNLs = flags & 1;
+            // Note: `multiple` flag is only unset for right-associative levels,
+            //  where the right-hand side already takes all operators of the same level.
 
-            auto op = maybeOp.unwrap("precParse -> maybeOp");
+            auto op = peek();
             logParse("precParse -> " + op.kindToString());
 
             justSkip(op.kind, skipRightNLs, op.toString(), "`precParse`");
+            skippedLeftNls = false;
 
-            auto maybeRhs = rightAssoc ? precParse(index) : precParse(index + 1);
+            const auto rhsBegin = cspan();
+            auto maybeRhs = prefix();
             if (!maybeRhs) {
                 // We continue, because we want to keep parsing expression even if rhs parsed unsuccessfully
-                // and `precParse` already generated error suggestion
                 continue;
             }
-            auto rhs = maybeRhs.unwrap("`precParse` -> `rhs`");
+
+            stack.push_back({
+                maybeLhs.unwrap(),
+                op,
+                begin,
+                static_cast<uint8_t>(rightAssoc ? level : level + 1)
+            });
+            begin = rhsBegin;
+            maybeLhs = maybeRhs.unwrap();
+        }
+
+        // Fold operators left after the end of expression
+        while (not stack.empty()) {
+            auto frame = std::move(stack.back());
+            stack.pop_back();
             maybeLhs = makeExpr<Infix>(
-                std::move(lhs), op, std::move(rhs), begin.to(cspan())
+                std::move(frame.lhs), frame.op, maybeLhs.unwrap(), frame.begin.to(cspan())
             );
-            if (!multiple) {
-                break;
-            }
-            begin = cspan();
         }
 
         return maybeLhs;
@@ -1174,39 +1210,59 @@ namespace jc::parser {
     };
 
     opt_expr_ptr Parser::prefix() {
-        const auto & begin = cspan();
-        const auto & op = peek();
-        if (skipOpt(TokenKind::Not, true) or skipOpt(TokenKind::Sub, true) or skipOpt(TokenKind::BitAnd, true) or
-            skipOpt(TokenKind::And, true) or skipOpt(TokenKind::Mul, true)) {
-            auto maybeRhs = prefix();
-            if (!maybeRhs) {
-                suggestErrorMsg("Expression expected after prefix operator " + op.toString(), cspan());
-                return quest(); // FIXME: CHECK!!!
+        // Prefix operators are collected in loop and applied to operand from the innermost one
+        struct PrefixOp {
+            Token op;
+            Span begin;
+            bool mut;
+        };
+        std::vector<PrefixOp> ops;
+
+        while (!eof()) {
+            const auto & begin = cspan();
+            const auto & op = peek();
+            if (not(skipOpt(TokenKind::Not, true) or skipOpt(TokenKind::Sub, true) or skipOpt(TokenKind::BitAnd, true) or
+                skipOpt(TokenKind::And, true) or skipOpt(TokenKind::Mul, true))) {
+                break;
             }
-            auto rhs = maybeRhs.unwrap();
+
+            bool mut = false;
+            if (op.is(TokenKind::BitAnd) or op.is(TokenKind::And)) {
+                mut = skipOpt(TokenKind::Mut, true);
+            }
+            ops.push_back({op, begin, mut});
+        }
+
+        auto maybeRhs = quest();
+        if (ops.empty()) {
+            return maybeRhs;
+        }
+
+        if (!maybeRhs) {
+            suggestErrorMsg("Expression expected after prefix operator " + ops.back().op.toString(), cspan());
+            return dt::None;
+        }
+
+        auto rhs = maybeRhs.unwrap();
+        for (auto it = ops.rbegin(); it != ops.rend(); it++) {
+            const auto & op = it->op;
+            const auto & span = it->begin.to(cspan());
             if (op.is(TokenKind::BitAnd) or op.is(TokenKind::And)) {
                 logParse("Borrow");
 
-                bool mut = skipOpt(TokenKind::Mut, true);
-                return Expr::pureAsBase(
-                    makeNode<BorrowExpr>(op.is(TokenKind::And), mut, std::move(rhs), begin.to(cspan()))
-                );
+                rhs = Expr::pureAsBase(makeNode<BorrowExpr>(op.is(TokenKind::And), it->mut, std::move(rhs), span));
             } else if (op.is(TokenKind::Mul)) {
                 logParse("Deref");
 
-                return Expr::pureAsBase(
-                    makeNode<DerefExpr>(std::move(rhs), begin.to(cspan()))
-                );
-            }
-
-            logParse("Prefix");
+                rhs = Expr::pureAsBase(makeNode<DerefExpr>(std::move(rhs), span));
+            } else {
+                logParse("Prefix");
 
-            return Expr::pureAsBase(
-                makeNode<Prefix>(op, std::move(rhs), begin.to(cspan()))
-            );
+                rhs = Expr::pureAsBase(makeNode<Prefix>(op, std::move(rhs), span));
+            }
         }
 
-        return quest();
+        return rhs;
     }
 
     opt_expr_ptr Parser::quest() {
@@ -1366,7 +1422,7 @@ namespace jc::parser {
         const auto & begin = cspan();
         auto token = peek();
         justSkip(TokenKind::Id, skipRightNLs, "[identifier]", "`" + panicIn + "`");
-        return makeNode<Identifier>(token, begin.to(cspan()));
+        return makeNode<Identifier>(span::Symbol::intern(token.val), begin.to(cspan()));
     }
 
     id_ptr Parser::parseId(const std::string & expected, bool skipLeftNLs, bool skipRightNls) {
@@ -1377,7 +1433,9 @@ namespace jc::parser {
         const auto & span = cspan();
         auto maybeIdToken = skip(TokenKind::Id, skipLeftNLs, skipRightNls, expected, Recovery::Any);
         if (maybeIdToken) {
-            return makeNode<Identifier>(maybeIdToken.unwrap("parseId -> maybeIdToken"), span);
+            return makeNode<Identifier>(
+                span::Symbol::intern(maybeIdToken.unwrap("parseId -> maybeIdToken").val), span
+            );
         }
         return makeErrorNode(span);
     }
@@ -1770,6 +1828,12 @@ namespace jc::parser {
 
         const auto & begin = cspan();
 
+        // Note: `elif` chain is a chain of nested `if` expressions
+        const NestingGuard nesting(nestingDepth);
+        if (nestingDepth > maxNesting) {
+            return recoverTooDeepNesting();
+        }
+
         if (isElif) {
             justSkip(TokenKind::Elif, true, "`elif`", "`parseIfExpr`");
         } else {
@@ -1806,7 +1870,11 @@ namespace jc::parser {
         } else if (is(TokenKind::Elif)) {
             stmt_list elif;
             const auto & elifBegin = cspan();
-            elif.push_back(makeStmt<ExprStmt>(parseIfExpr(true), elifBegin.to(cspan())));
+            // Each `elif` is nested `if`, so long chains continue on new stack segments as other recursive sites
+            auto elifExpr = utils::stack::ensureSufficient([&]() {
+                return parseIfExpr(true);
+            });
+            elif.push_back(makeStmt<ExprStmt>(std::move(elifExpr), elifBegin.to(cspan())));
             elseBranch = makeNode<Block>(std::move(elif), elifBegin.to(cspan()));
         }
 
@@ -2188,9 +2256,15 @@ namespace jc::parser {
                 segments.emplace_back(makeNode<SimplePathSeg>(SimplePathSeg::Kind::Self, segBegin));
             }
 
+            // Note: `::` followed by `*` or `{` belongs to `use` tree, not to the path
             if (not is(TokenKind::Path)) {
                 break;
             }
+            const auto & next = lookup();
+            if (not next.is(TokenKind::Id) and not next.is(TokenKind::Super)
+                and not next.is(TokenKind::Party) and not next.is(TokenKind::Self)) {
+                break;
+            }
 
             justSkip(TokenKind::Path, false, "`::`", "`parseOptSimplePath`");
         }
@@ -2554,6 +2628,33 @@ namespace jc::parser {
         );
     }
 
+    // Nesting //
+    expr_ptr Parser::recoverTooDeepNesting() {
+        const auto & begin = cspan();
+        suggestErrorMsg(
+            "Expression nesting is too deep, limit is " + std::to_string(maxNesting) + " (set with `-max-nesting`)",
+            begin
+        );
+
+        // Skip the rest of nested expression without parsing it, stopping at closing token of enclosing one
+        uint32_t depth = 0;
+        while (!eof()) {
+            if (is({TokenKind::LParen, TokenKind::LBracket, TokenKind::LBrace})) {
+                depth++;
+            } else if (is({TokenKind::RParen, TokenKind::RBracket, TokenKind::RBrace})) {
+                if (depth == 0) {
+                    break;
+                }
+                depth--;
+            } else if (depth == 0 and (isNL() or is(TokenKind::Semi) or is(TokenKind::Comma))) {
+                break;
+            }
+            advance();
+        }
+
+        return makeErrorNode(begin.to(cspan()));
+    }
+
     Span Parser::cspan() const {
         return peek().span;
     }
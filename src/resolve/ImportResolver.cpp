@@ -0,0 +1,214 @@
+#include "resolve/ImportResolver.h"
+
+namespace jc::resolve {
+    dt::SuggResult<dt::none_t> ImportResolver::resolve(const sess::sess_ptr & sess) {
+        this->sess = sess;
+        root = sess->modTreeRoot.unwrap();
+        imports.clear();
+
+        initVisible(root);
+        collectImports(root);
+
+        // Each round either makes some name visible or stops, names count is finite
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (auto & import : imports) {
+                // Glob target can get new names on each round, so globs are applied until fixed point
+                if (import.glob or not import.resolved) {
+                    changed |= applyImport(import);
+                }
+            }
+        }
+
+        buildFilters(root);
+
+        for (const auto & import : imports) {
+            if (not import.resolved) {
+                suggestErrorMsg(
+                    "Unresolved import `" + PathResolver::pathToString(import.global, import.path) + "`",
+                    sess->nodeMap.getNodeSpan(import.useTreeId)
+                );
+            }
+        }
+
+        return {dt::None, extractSuggestions()};
+    }
+
+    void ImportResolver::initVisible(const mod_node_ptr & mod) {
+        mod->visibleValueNS = mod->valueNS;
+        mod->visibleTypeNS = mod->typeNS;
+        mod->visibleMods = mod->children;
+        mod->children.forEach([&](span::Symbol, const mod_node_ptr & child) {
+            initVisible(child);
+        });
+    }
+
+    void ImportResolver::buildFilters(const mod_node_ptr & mod) {
+        mod->buildFilters();
+        mod->children.forEach([&](span::Symbol, const mod_node_ptr & child) {
+            buildFilters(child);
+        });
+    }
+
+    void ImportResolver::collectImports(const mod_node_ptr & mod) {
+        for (const auto & useDeclId : mod->useDecls) {
+            const auto & useDecl = std::static_pointer_cast<ast::UseDecl>(sess->nodeMap.getNodePtr(useDeclId));
+            collectUseTree(mod, useDecl->useTree, false, {});
+        }
+        mod->children.forEach([&](span::Symbol, const mod_node_ptr & child) {
+            collectImports(child);
+        });
+    }
+
+    void ImportResolver::collectUseTree(
+        const mod_node_ptr & mod,
+        const ast::use_tree_ptr & maybeUseTree,
+        bool global,
+        const path_segs & prefix
+    ) {
+        if (maybeUseTree.isErr()) {
+            return;
+        }
+
+        const auto & useTree = maybeUseTree.unwrap();
+        auto path = prefix;
+        switch (useTree->kind) {
+            case ast::UseTree::Kind::Raw: {
+                const auto & raw = std::static_pointer_cast<ast::UseTreeRaw>(useTree);
+                global |= raw->path->global;
+                if (not appendPath(raw->path, path) or path.empty()) {
+                    return;
+                }
+                imports.push_back({mod, useTree->id, global, path, false, path.back()});
+                break;
+            }
+            case ast::UseTree::Kind::Rebind: {
+                const auto & rebind = std::static_pointer_cast<ast::UseTreeRebind>(useTree);
+                global |= rebind->path->global;
+                if (not appendPath(rebind->path, path) or path.empty() or rebind->as.isErr()) {
+                    return;
+                }
+                imports.push_back({mod, useTree->id, global, path, false, rebind->as.unwrap()->sym});
+                break;
+            }
+            case ast::UseTree::Kind::All: {
+                const auto & all = std::static_pointer_cast<ast::UseTreeAll>(useTree);
+                if (all->path) {
+                    global |= all->path.unwrap()->global;
+                    if (not appendPath(all->path.unwrap(), path)) {
+                        return;
+                    }
+                }
+                imports.push_back({mod, useTree->id, global, path, true, span::Symbol{}});
+                break;
+            }
+            case ast::UseTree::Kind::Specific: {
+                const auto & specific = std::static_pointer_cast<ast::UseTreeSpecific>(useTree);
+                if (specific->path) {
+                    global |= specific->path.unwrap()->global;
+                    if (not appendPath(specific->path.unwrap(), path)) {
+                        return;
+                    }
+                }
+                for (const auto & nested : specific->specifics) {
+                    collectUseTree(mod, nested, global, path);
+                }
+                break;
+            }
+        }
+    }
+
+    bool ImportResolver::appendPath(const ast::simple_path_ptr & path, path_segs & segs) {
+        for (const auto & seg : path->segments) {
+            switch (seg->kind) {
+                case ast::SimplePathSeg::Kind::Super: {
+                    segs.push_back(PathResolver::superSym());
+                    break;
+                }
+                case ast::SimplePathSeg::Kind::Self: {
+                    segs.push_back(PathResolver::selfSym());
+                    break;
+                }
+                case ast::SimplePathSeg::Kind::Party: {
+                    segs.push_back(PathResolver::partySym());
+                    break;
+                }
+                case ast::SimplePathSeg::Kind::Ident: {
+                    if (not seg->ident or seg->ident.unwrap().isErr()) {
+                        return false;
+                    }
+                    segs.push_back(seg->ident.unwrap().unwrap()->sym);
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool ImportResolver::applyImport(Import & import) {
+        auto & mod = import.mod;
+        bool changed = false;
+
+        if (import.glob) {
+            const auto & target = PathResolver::walkModPath(
+                root, mod, import.global, import.path.begin(), import.path.end()
+            );
+            if (not target) {
+                return false;
+            }
+            import.resolved = true;
+
+            // Own and already imported names are not overridden by glob
+            const auto & targetMod = target.unwrap();
+            if (targetMod == mod) {
+                // Glob import of own names (e.g. `use self::*`) adds nothing, and its maps must not be inserted into
+                //  while they are iterated
+                return false;
+            }
+            targetMod->visibleValueNS.forEach([&](span::Symbol name, node_id nodeId) {
+                changed |= mod->visibleValueNS.emplace(name, nodeId).second;
+            });
+            targetMod->visibleTypeNS.forEach([&](span::Symbol name, node_id nodeId) {
+                changed |= mod->visibleTypeNS.emplace(name, nodeId).second;
+            });
+            targetMod->visibleMods.forEach([&](span::Symbol name, const mod_node_ptr & child) {
+                changed |= mod->visibleMods.emplace(name, child).second;
+            });
+            return changed;
+        }
+
+        const auto & value = PathResolver::lookup(root, mod, import.global, import.path, Namespace::Value);
+        const auto & type = PathResolver::lookup(root, mod, import.global, import.path, Namespace::Type);
+        const auto & module = PathResolver::walkModPath(
+            root, mod, import.global, import.path.begin(), import.path.end()
+        );
+        if (not value and not type and not module) {
+            return false;
+        }
+        import.resolved = true;
+
+        auto bind = [&](auto & ns, const auto & item) {
+            const auto & inserted = ns.emplace(import.bindName, item);
+            if (inserted.second) {
+                changed = true;
+            } else if (*inserted.first != item) {
+                suggestErrorMsg(
+                    "Cannot import `" + import.bindName.toString() + "`, this name is already used in the module",
+                    sess->nodeMap.getNodeSpan(import.useTreeId)
+                );
+            }
+        };
+
+        if (value) {
+            bind(mod->visibleValueNS, value.unwrap());
+        }
+        if (type) {
+            bind(mod->visibleTypeNS, type.unwrap());
+        }
+        if (module) {
+            bind(mod->visibleMods, module.unwrap());
+        }
+        return changed;
+    }
+}
@@ -1,6 +1,19 @@
 #include "resolve/Module.h"
 
 namespace jc::resolve {
+    // ModNode //
+    void ModNode::buildFilters() {
+        const auto fill = [](dt::BloomFilter & filter, const auto & map) {
+            filter.reset(map.size());
+            map.forEach([&](span::Symbol name, const auto &) {
+                filter.insert(name.getId());
+            });
+        };
+        fill(visibleValueFilter, visibleValueNS);
+        fill(visibleTypeFilter, visibleTypeNS);
+        fill(visibleModsFilter, visibleMods);
+    }
+
     // ModulePrinter //
     ModulePrinter::ModulePrinter() {
         log.getConfig().printOwner = false;
@@ -10,21 +23,33 @@ namespace jc::resolve {
         log.raw("{");
         log.nl();
         indent++;
-        for (const auto & child : module->children) {
+        // Note: Namespaces are hash maps keyed by symbol, sort by name to keep output stable
+        std::map<std::string, mod_node_ptr> children;
+        module->children.forEach([&](span::Symbol name, const mod_node_ptr & child) {
+            children.emplace(name.toString(), child);
+        });
+        for (const auto & child : children) {
             printIndent();
             log.raw(child.first + " ");
             print(child.second);
             log.nl();
         }
-        printIndent();
-        log.raw("[values]:", module->valueNS).nl();
-        printIndent();
-        log.raw("[types]:", module->typeNS).nl();
+        printNS("[values]:", module->valueNS);
+        printNS("[types]:", module->typeNS);
         indent--;
         printIndent();
         log.raw("}");
     }
 
+    void ModulePrinter::printNS(const std::string & title, const mod_ns_map & ns) {
+        std::map<std::string, node_id> names;
+        ns.forEach([&](span::Symbol name, node_id nodeId) {
+            names.emplace(name.toString(), nodeId);
+        });
+        printIndent();
+        log.raw(title, names).nl();
+    }
+
     void ModulePrinter::printIndent() {
         log.raw(utils::str::repeat("  ", indent));
     }
@@ -0,0 +1,272 @@
+#include "resolve/ModuleMeta.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace jc::resolve {
+    namespace {
+        class MetaBuilder {
+        public:
+            uint32_t addString(const std::string & str) {
+                const auto & found = stringOffsets.find(str);
+                if (found != stringOffsets.end()) {
+                    return found->second;
+                }
+                const auto offset = static_cast<uint32_t>(strings.size());
+                const auto len = static_cast<uint32_t>(str.size());
+                append(strings, &len, sizeof(len));
+                strings.insert(strings.end(), str.begin(), str.end());
+                // Keep next string 4-byte aligned
+                strings.resize((strings.size() + 3) & ~static_cast<size_t>(3), 0);
+                stringOffsets.emplace(str, offset);
+                return offset;
+            }
+
+            template<class T>
+            static void append(std::vector<uint8_t> & buffer, const T * data, size_t size) {
+                const auto * bytes = reinterpret_cast<const uint8_t*>(data);
+                buffer.insert(buffer.end(), bytes, bytes + size);
+            }
+
+            std::vector<ModuleMeta::ModRecord> modules;
+            std::vector<ModuleMeta::DefRecord> defs;
+            std::vector<uint8_t> strings;
+
+        private:
+            std::unordered_map<std::string, uint32_t> stringOffsets;
+        };
+
+        /// Records are ordered by name, so layout does not depend on order symbols were interned in
+        bool nameLess(const span::Symbol & lhs, const span::Symbol & rhs) {
+            return lhs.toString() < rhs.toString();
+        }
+
+        bool isExternMod(const sess::sess_ptr & sess, const mod_node_ptr & mod) {
+            for (const auto & externMod : sess->externMods) {
+                if (externMod.second == mod) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void addDefs(
+            const sess::sess_ptr & sess,
+            MetaBuilder & builder,
+            const mod_ns_map & ns,
+            Namespace nsKind
+        ) {
+            for (const auto & def : ns.sorted(nameLess)) {
+                const auto & item = std::static_pointer_cast<ast::Item>(sess->nodeMap.getNodePtr(def.second));
+                uint16_t arity = 0;
+                if (item->kind == ast::ItemKind::Func) {
+                    arity = static_cast<uint16_t>(std::static_pointer_cast<ast::Func>(item)->params.size());
+                } else if (item->kind == ast::ItemKind::Struct) {
+                    arity = static_cast<uint16_t>(std::static_pointer_cast<ast::Struct>(item)->fields.size());
+                }
+                const auto & span = item->span;
+                builder.defs.push_back({
+                    builder.addString(def.first.toString()),
+                    builder.addString(sess->sourceMap.getSourceFile(span.getFileId()).path.string()),
+                    span.getPos(),
+                    span.getLen(),
+                    static_cast<uint8_t>(nsKind),
+                    static_cast<uint8_t>(item->kind),
+                    arity,
+                });
+            }
+        }
+
+        void addModule(
+            const sess::sess_ptr & sess,
+            MetaBuilder & builder,
+            const mod_node_ptr & mod,
+            const std::string & name,
+            uint32_t parent
+        ) {
+            const auto index = static_cast<uint32_t>(builder.modules.size());
+            builder.modules.push_back({builder.addString(name), parent, static_cast<uint32_t>(builder.defs.size()), 0});
+            addDefs(sess, builder, mod->valueNS, Namespace::Value);
+            addDefs(sess, builder, mod->typeNS, Namespace::Type);
+            builder.modules.at(index).defsCount = static_cast<uint32_t>(builder.defs.size()) - builder.modules.at(index).firstDef;
+
+            for (const auto & child : mod->children.sorted(nameLess)) {
+                if (isExternMod(sess, child.second)) {
+                    continue;
+                }
+                addModule(sess, builder, child.second, child.first.toString(), index);
+            }
+        }
+
+        bool inBounds(uint64_t offset, uint64_t count, uint64_t itemSize, uint64_t size) {
+            return offset + count * itemSize <= size;
+        }
+    }
+
+    bool ModuleMeta::write(
+        const sess::sess_ptr & sess,
+        const mod_node_ptr & root,
+        const std::string & partyName,
+        const std::filesystem::path & path
+    ) {
+        MetaBuilder builder;
+        const auto partyNameOffset = builder.addString(partyName);
+        addModule(sess, builder, root, partyName, NO_PARENT);
+
+        // Offsets and sizes are stored as 32-bit, metadata which does not fit is not written
+        const uint64_t modulesOffset = sizeof(Header);
+        const uint64_t defsOffset = modulesOffset + uint64_t{builder.modules.size()} * sizeof(ModRecord);
+        const uint64_t stringsOffset = defsOffset + uint64_t{builder.defs.size()} * sizeof(DefRecord);
+        if (stringsOffset + uint64_t{builder.strings.size()} > UINT32_MAX) {
+            return false;
+        }
+
+        Header header{};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.partyName = partyNameOffset;
+        header.modulesOffset = static_cast<uint32_t>(modulesOffset);
+        header.modulesCount = static_cast<uint32_t>(builder.modules.size());
+        header.defsOffset = static_cast<uint32_t>(defsOffset);
+        header.defsCount = static_cast<uint32_t>(builder.defs.size());
+        header.stringsOffset = static_cast<uint32_t>(stringsOffset);
+        header.stringsSize = static_cast<uint32_t>(builder.strings.size());
+
+        std::vector<uint8_t> data;
+        MetaBuilder::append(data, &header, sizeof(header));
+        MetaBuilder::append(data, builder.modules.data(), builder.modules.size() * sizeof(ModRecord));
+        MetaBuilder::append(data, builder.defs.data(), builder.defs.size() * sizeof(DefRecord));
+        MetaBuilder::append(data, builder.strings.data(), builder.strings.size());
+
+        // Write to temporary file and rename, so readers never see partially written metadata
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            if (not file.is_open()) {
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (not file.good()) {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        return not ec;
+    }
+
+    dt::Option<mod_node_ptr> ModuleMeta::load(
+        const sess::sess_ptr & sess,
+        const std::filesystem::path & path,
+        span::Symbol & partyName,
+        std::string & error
+    ) {
+        fs::MappedFile file;
+        if (not file.open(path)) {
+            error = "cannot open file";
+            return dt::None;
+        }
+
+        const auto * data = file.data();
+        const auto size = file.size();
+        if (size < sizeof(Header)) {
+            error = "file is too small";
+            return dt::None;
+        }
+
+        Header header{};
+        std::memcpy(&header, data, sizeof(Header));
+        if (header.magic != MAGIC) {
+            error = "not a module metadata file";
+            return dt::None;
+        }
+        if (header.version != VERSION) {
+            error = "unsupported version " + std::to_string(header.version);
+            return dt::None;
+        }
+        if (not inBounds(header.modulesOffset, header.modulesCount, sizeof(ModRecord), size)
+            or not inBounds(header.defsOffset, header.defsCount, sizeof(DefRecord), size)
+            or not inBounds(header.stringsOffset, header.stringsSize, 1, size)
+            or header.modulesCount == 0) {
+            error = "corrupted file";
+            return dt::None;
+        }
+
+        const auto * strings = data + header.stringsOffset;
+        bool corrupted = false;
+        const auto readString = [&](uint32_t offset) -> std::string {
+            uint32_t len = 0;
+            if (not inBounds(offset, 1, sizeof(len), header.stringsSize)) {
+                corrupted = true;
+                return "";
+            }
+            std::memcpy(&len, strings + offset, sizeof(len));
+            if (not inBounds(offset + sizeof(len), len, 1, header.stringsSize)) {
+                corrupted = true;
+                return "";
+            }
+            return std::string(reinterpret_cast<const char*>(strings + offset + sizeof(len)), len);
+        };
+
+        partyName = span::Symbol::intern(readString(header.partyName));
+
+        std::vector<mod_node_ptr> modules;
+        modules.reserve(header.modulesCount);
+        for (uint32_t i = 0; i < header.modulesCount and not corrupted; i++) {
+            ModRecord record{};
+            std::memcpy(&record, data + header.modulesOffset + i * sizeof(ModRecord), sizeof(ModRecord));
+
+            const auto name = span::Symbol::intern(readString(record.name));
+            mod_node_ptr mod;
+            if (i == 0) {
+                // Precompiled party is mounted into module tree root by its name
+                mod = std::make_shared<ModNode>(dt::None);
+                mod->path = {partyName};
+            } else {
+                if (record.parent >= i) {
+                    corrupted = true;
+                    break;
+                }
+                const auto & parent = modules.at(record.parent);
+                mod = std::make_shared<ModNode>(parent);
+                mod->path = parent->path;
+                mod->path.push_back(name);
+                parent->children.emplace(name, mod);
+            }
+
+            if (not inBounds(record.firstDef, record.defsCount, 1, header.defsCount)) {
+                corrupted = true;
+                break;
+            }
+            for (uint32_t d = record.firstDef; d < record.firstDef + record.defsCount; d++) {
+                DefRecord def{};
+                std::memcpy(&def, data + header.defsOffset + d * sizeof(DefRecord), sizeof(DefRecord));
+                if (def.ns > static_cast<uint8_t>(Namespace::Type) or def.kind > static_cast<uint8_t>(ast::ItemKind::Use)) {
+                    corrupted = true;
+                    break;
+                }
+                const auto defName = span::Symbol::intern(readString(def.name));
+                const auto id = sess->nodeMap.reserveId();
+                mod->getNS(static_cast<Namespace>(def.ns))[defName] = id;
+                sess->externDefs.emplace(id, ExternDef{
+                    defName,
+                    static_cast<ast::ItemKind>(def.kind),
+                    def.arity,
+                    span::Symbol::intern(readString(def.file)),
+                    def.pos,
+                    def.len,
+                });
+            }
+
+            modules.push_back(mod);
+        }
+
+        if (corrupted) {
+            error = "corrupted file";
+            return dt::None;
+        }
+
+        return modules.at(0);
+    }
+}
@@ -1,28 +1,53 @@
 #include "resolve/ModuleTreeBuilder.h"
 
+#include <filesystem>
+
 namespace jc::resolve {
     dt::SuggResult<dt::none_t> ModuleTreeBuilder::build(sess::sess_ptr sess, const ast::Party & party) {
+        this->sess = sess;
+        sess->fileModules.clear();
         party.getRootModule()->accept(*this);
+
+        // Precompiled parties are loaded once per session and mounted into each new module tree
+        for (const auto & externMod : sess->externMods) {
+            if (mod->children.has(externMod.first)) {
+                log.error(
+                    "Precompiled party `" + externMod.first.toString() + "` is not mounted,",
+                    "module with the same name already exists"
+                );
+                continue;
+            }
+            mod->children.emplace(externMod.first, externMod.second);
+        }
+
         sess->modTreeRoot = mod;
 
         return {dt::None, std::move(extractSuggestions())};
     }
 
     void ModuleTreeBuilder::visit(const ast::RootModule & rootModule) {
+        // Root file is the root module of party, modules of root directory are its children
         mod = std::make_shared<ModNode>(dt::None);
-        rootModule.getRootFile()->accept(*this);
-        rootModule.getRootDir()->accept(*this);
+        const auto & rootFile = rootModule.getRootFile();
+        sess->fileModules.emplace(rootFile->getFileId(), mod);
+        rootFile->getFile()->accept(*this);
+        for (const auto & module : rootModule.getRootDir()->getModules()) {
+            module->accept(*this);
+        }
     }
 
     void ModuleTreeBuilder::visit(const ast::FileModule & fileModule) {
-        // This is actually impossible to redeclare file, filesystem does not allow it
-        enterMod(fileModule.getName(), dt::None);
+        // This is actually impossible to redeclare file, filesystem does not allow it.
+        // File module is named by file name without extension, so it can be used in paths
+        const auto & name = std::filesystem::path(fileModule.getName()).stem().string();
+        enterMod(span::Symbol::intern(name), dt::None);
+        sess->fileModules.emplace(fileModule.getFileId(), mod);
         fileModule.getFile()->accept(*this);
         exitMod();
     }
 
     void ModuleTreeBuilder::visit(const ast::DirModule & dirModule) {
-        enterMod(dirModule.getName(), dt::None);
+        enterMod(span::Symbol::intern(dirModule.getName()), dt::None);
         for (const auto & module : dirModule.getModules()) {
             module->accept(*this);
         }
@@ -34,18 +59,18 @@ namespace jc::resolve {
     }
 
     void ModuleTreeBuilder::visit(const ast::Mod & mod) {
-        enterMod(mod.name.unwrap()->getValue(), mod.name.unwrap()->span);
+        enterMod(mod.name.unwrap()->sym, mod.name.unwrap()->span);
         visitEach(mod.items);
         exitMod();
     }
 
     void ModuleTreeBuilder::visit(const ast::Struct & _struct) {
-        declare(Namespace::Value, _struct.name, _struct.id);
+        declare(Namespace::Type, _struct.name, _struct.id);
         StubVisitor::visit(_struct);
     }
 
     void ModuleTreeBuilder::visit(const ast::Trait & trait) {
-        enterMod(trait.name.unwrap()->getValue(), trait.name.unwrap()->span);
+        enterMod(trait.name.unwrap()->sym, trait.name.unwrap()->span);
         visitEach(trait.members);
         exitMod();
     }
@@ -55,28 +80,34 @@ namespace jc::resolve {
         typeAlias.type.accept(*this);
     }
 
+    void ModuleTreeBuilder::visit(const ast::UseDecl & useDecl) {
+        mod->useDecls.push_back(useDecl.id);
+    }
+
     // Modules //
     void ModuleTreeBuilder::declare(Namespace ns, const ast::id_ptr & ident, node_id nodeId) {
-        const auto & name = ident.unwrap()->getValue();
+        const auto & name = ident.unwrap()->sym;
         auto & map = mod->getNS(ns);
-        if (utils::map::has(map, name)) {
-            suggestErrorMsg("'" + name + "' `mod` has been already declared", ident.unwrap()->span);
+        if (map.has(name)) {
+            suggestErrorMsg("'" + name.toString() + "' `mod` has been already declared", ident.unwrap()->span);
         }
         map[name] = nodeId;
     }
 
     /// Optional for filesystem modules (file/dir does not have span)
-    void ModuleTreeBuilder::enterMod(const std::string & name, const dt::Option<span::Span> & nameSpan) {
-        if (utils::map::has(mod->children, name)) {
+    void ModuleTreeBuilder::enterMod(span::Symbol name, const dt::Option<span::Span> & nameSpan) {
+        if (mod->children.has(name)) {
             if (not nameSpan) {
                 log.devPanic(
                     "This is impossible to enter module which is file/dir and which has been already declared"
                 );
             } else {
-                suggestErrorMsg("'" + name + "' `mod` has been already declared", nameSpan.unwrap());
+                suggestErrorMsg("'" + name.toString() + "' `mod` has been already declared", nameSpan.unwrap());
             }
         }
         auto child = std::make_shared<ModNode>(mod);
+        child->path = mod->path;
+        child->path.push_back(name);
         // TODO: Check for redeclaration
         mod->children.emplace(name, child);
         mod = child;
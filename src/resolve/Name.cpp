@@ -1,35 +1,115 @@
 #include "resolve/Name.h"
 
 namespace jc::resolve {
-    decl_result Rib::declare(const std::string & name, Name::Kind kind, ast::node_id nodeId) {
-        auto & ns = getNSForName(kind);
-        const auto & found = ns.find(name);
-        if (found == ns.end()) {
-            ns.emplace(name, std::make_shared<Name>(kind, nodeId));
-            return dt::None;
+    Namespace Name::getNS(Kind kind) {
+        switch (kind) {
+            case Kind::Const:
+            case Kind::Param:
+            case Kind::Local:
+            case Kind::ConstParam:
+            case Kind::Func: {
+                return Namespace::Value;
+            }
+            case Kind::Enum:
+            case Kind::Struct:
+            case Kind::Trait:
+            case Kind::TypeAlias:
+            case Kind::TypeParam: {
+                return Namespace::Type;
+            }
+            case Kind::Lifetime: {
+                return Namespace::Lifetime;
+            }
         }
-        return found->second;
+        common::Logger::devPanic("Invalid `Name::Kind` in `Name::getNS`");
     }
 
-    ns_map & Rib::getNSForName(Name::Kind kind) {
-        switch (kind) {
-            case Name::Kind::Const:
-            case Name::Kind::Param:
-            case Name::Kind::Local:
-            case Name::Kind::ConstParam:
-            case Name::Kind::Func: {
-                return valueNS;
-            }
-            case Name::Kind::Enum:
-            case Name::Kind::Struct:
-            case Name::Kind::Trait:
-            case Name::Kind::TypeAlias:
-            case Name::Kind::TypeParam: {
-                return typeNS;
+    // ScopeTable //
+    void ScopeTable::enterRib(Rib::Kind kind) {
+        ribs.push_back({kind, undoLog.size()});
+    }
+
+    void ScopeTable::exitRib() {
+        if (ribs.empty()) {
+            common::Logger::devPanic("ScopeTable: Tried to exit rib with empty rib stack");
+        }
+
+        const auto undoMark = ribs.back().undoMark;
+        ribs.pop_back();
+
+        // Roll back declarations of exited rib in reverse order, restoring shadowed bindings
+        while (undoLog.size() > undoMark) {
+            const auto & entry = undoLog.back();
+            auto & ns = getNS(entry.ns);
+            if (entry.shadowed) {
+                ns.at(entry.name) = entry.shadowed.unwrap();
+            } else {
+                ns.erase(entry.name);
             }
-            case Name::Kind::Lifetime: {
-                return lifetimeNS;
+            undoLog.pop_back();
+        }
+    }
+
+    uint32_t ScopeTable::getDepth() const {
+        return static_cast<uint32_t>(ribs.size());
+    }
+
+    void ScopeTable::clear() {
+        valueNS.clear();
+        typeNS.clear();
+        lifetimeNS.clear();
+        undoLog.clear();
+        ribs.clear();
+    }
+
+    opt_binding ScopeTable::declare(span::Symbol name, Name::Kind kind, node_id nodeId) {
+        if (ribs.empty()) {
+            common::Logger::devPanic("ScopeTable: Tried to declare name '" + name.toString() + "' out of rib");
+        }
+
+        const auto nsKind = Name::getNS(kind);
+        auto & ns = getNS(nsKind);
+        const auto depth = getDepth();
+
+        opt_binding shadowed{dt::None};
+        const auto found = ns.find(name);
+        if (found) {
+            const auto & prev = *found;
+            // Locals are allowed to shadow locals declared in the same block
+            if (prev.ribDepth == depth and not(prev.kind == Name::Kind::Local and kind == Name::Kind::Local)) {
+                return prev;
             }
+            shadowed = prev;
+        }
+
+        undoLog.push_back({nsKind, name, shadowed});
+        ns[name] = {kind, nodeId, depth};
+        return dt::None;
+    }
+
+    opt_binding ScopeTable::lookup(Namespace ns, span::Symbol name) const {
+        const auto found = getNS(ns).find(name);
+        if (not found) {
+            return dt::None;
+        }
+        return *found;
+    }
+
+    ScopeTable::binding_map & ScopeTable::getNS(Namespace ns) {
+        switch (ns) {
+            case Namespace::Value: return valueNS;
+            case Namespace::Type: return typeNS;
+            case Namespace::Lifetime: return lifetimeNS;
+        }
+        common::Logger::devPanic("Invalid `ScopeTable` namespace specified");
+    }
+
+    const ScopeTable::binding_map & ScopeTable::getNS(Namespace ns) const {
+        switch (ns) {
+            case Namespace::Value: return valueNS;
+            case Namespace::Type: return typeNS;
+            case Namespace::Lifetime: return lifetimeNS;
         }
+        common::Logger::devPanic("Invalid `ScopeTable` namespace specified");
     }
 }
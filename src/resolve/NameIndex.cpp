@@ -0,0 +1,129 @@
+#include "resolve/NameIndex.h"
+
+#include <algorithm>
+
+#include "utils/hash.h"
+
+namespace jc::resolve {
+    std::vector<NameIndex::Candidate> NameIndex::query(const std::string & name) {
+        const auto maxDistance = maxDistanceFor(name);
+        if (maxDistance == 0) {
+            return {};
+        }
+
+        std::vector<span::sym_id_t> ids;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            update();
+            forEachDelete(name.substr(0, PREFIX_LEN), [&](const std::string & del, uint32_t deleted) {
+                if (deleted > maxDistance) {
+                    return;
+                }
+                const auto & found = deletes.find(hashStr(del));
+                if (found != deletes.end()) {
+                    ids.insert(ids.end(), found->second.begin(), found->second.end());
+                }
+            });
+        }
+
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+        std::vector<Candidate> candidates;
+        for (const auto id : ids) {
+            const auto sym = span::Symbol(id);
+            const auto & str = sym.toString();
+            if (str == name) {
+                continue;
+            }
+            const auto distance = editDistance(name, str);
+            if (distance <= maxDistance) {
+                candidates.push_back({sym, distance});
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate & lhs, const Candidate & rhs) {
+            if (lhs.distance != rhs.distance) {
+                return lhs.distance < rhs.distance;
+            }
+            return lhs.sym.toString() < rhs.sym.toString();
+        });
+
+        return candidates;
+    }
+
+    uint32_t NameIndex::maxDistanceFor(const std::string & name) {
+        // One typo per three chars, so short names are not matched with everything
+        return std::min<uint32_t>(MAX_DISTANCE, static_cast<uint32_t>(name.size() / 3));
+    }
+
+    uint32_t NameIndex::editDistance(const std::string & lhs, const std::string & rhs) {
+        // Three rows of DP table are enough for adjacent transpositions
+        std::vector<uint32_t> prevPrev(rhs.size() + 1);
+        std::vector<uint32_t> prev(rhs.size() + 1);
+        std::vector<uint32_t> cur(rhs.size() + 1);
+        for (size_t j = 0; j <= rhs.size(); j++) {
+            prev[j] = static_cast<uint32_t>(j);
+        }
+
+        for (size_t i = 1; i <= lhs.size(); i++) {
+            cur[0] = static_cast<uint32_t>(i);
+            for (size_t j = 1; j <= rhs.size(); j++) {
+                const uint32_t cost = lhs[i - 1] == rhs[j - 1] ? 0 : 1;
+                cur[j] = std::min({prev[j] + 1, cur[j - 1] + 1, prev[j - 1] + cost});
+                if (i > 1 and j > 1 and lhs[i - 1] == rhs[j - 2] and lhs[i - 2] == rhs[j - 1]) {
+                    cur[j] = std::min(cur[j], prevPrev[j - 2] + 1);
+                }
+            }
+            std::swap(prevPrev, prev);
+            std::swap(prev, cur);
+        }
+
+        return prev[rhs.size()];
+    }
+
+    void NameIndex::update() {
+        // Symbols are never removed from interner, so only new ones are indexed
+        const auto & interner = span::Interner::getInstance();
+        const auto count = static_cast<span::sym_id_t>(interner.size());
+        for (auto id = indexedCount; id < count; id++) {
+            add(id, interner.get(id));
+        }
+        indexedCount = count;
+    }
+
+    void NameIndex::add(span::sym_id_t id, const std::string & str) {
+        if (str.empty()) {
+            return;
+        }
+        forEachDelete(str.substr(0, PREFIX_LEN), [&](const std::string & del, uint32_t) {
+            deletes[hashStr(del)].push_back(id);
+        });
+    }
+
+    template<class F>
+    void NameIndex::forEachDelete(const std::string & str, F && func) {
+        // Breadth-first generation of unique deletes, `func` receives each delete with count of deleted chars
+        std::vector<std::string> level = {str};
+        func(str, 0);
+        for (uint32_t deleted = 1; deleted <= MAX_DISTANCE; deleted++) {
+            std::vector<std::string> next;
+            for (const auto & word : level) {
+                for (size_t i = 0; i < word.size(); i++) {
+                    auto del = word.substr(0, i) + word.substr(i + 1);
+                    if (std::find(next.begin(), next.end(), del) == next.end()) {
+                        next.push_back(std::move(del));
+                    }
+                }
+            }
+            for (const auto & del : next) {
+                func(del, deleted);
+            }
+            level = std::move(next);
+        }
+    }
+
+    uint64_t NameIndex::hashStr(const std::string & str) {
+        return utils::hash::Hasher128().add(str).digest().low;
+    }
+}
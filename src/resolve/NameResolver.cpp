@@ -5,15 +5,226 @@ namespace jc::resolve {
         this->sess = sess;
         rootMod = sess->modTreeRoot.unwrap();
 
-        party.getRootModule()->accept(*this);
+        // Files don't share ribs, so each file is resolved independently by one of workers.
+        // Workers only read the module tree, ribs, suggestions and resolutions are per-worker,
+        //  results are merged in the order of sequential traversal, thus output does not depend on `jobs`.
+        std::vector<const ast::FileModule*> files;
+        collectFiles(*party.getRootModule(), files);
+
+        const auto jobs = std::min<size_t>(common::Config::getInstance().getJobs(), std::max<size_t>(files.size(), 1));
+        std::vector<std::unique_ptr<NameResolver>> workers;
+        for (size_t i = 0; i < jobs; i++) {
+            auto worker = std::make_unique<NameResolver>();
+            worker->sess = sess;
+            worker->rootMod = rootMod;
+            worker->pathResolver.reset(rootMod);
+            worker->resShard.clear();
+            workers.emplace_back(std::move(worker));
+        }
+
+        std::vector<sugg::sugg_list> fileSuggestions(files.size());
+        std::vector<std::vector<BodyRecord>> bodies(files.size());
+        utils::thread::parallelFor(jobs, files.size(), [&](size_t workerIndex, size_t fileIndex) {
+            auto & worker = *workers.at(workerIndex);
+            worker.resolveFile(*files.at(fileIndex));
+            fileSuggestions[fileIndex] = worker.extractSuggestions();
+            bodies[fileIndex] = std::move(worker.fileBodies);
+            worker.fileBodies.clear();
+        });
+
+        for (auto & suggestions : fileSuggestions) {
+            for (auto & sugg : suggestions) {
+                suggest(std::move(sugg));
+            }
+        }
+
+        sess->resStorage.reset(sess->nodeMap.idsCount());
+        FilterStats filterStats;
+        for (const auto & worker : workers) {
+            sess->resStorage.merge(worker->resShard);
+            filterStats += worker->pathResolver.getFilterStats();
+        }
+        logFilterStats(filterStats);
+
+        sess->resStorage.buildUses();
+
+        sess->bodyDeps.clear();
+        for (size_t i = 0; i < files.size(); i++) {
+            for (const auto & body : bodies.at(i)) {
+                lintUnusedLocals(body);
+            }
+            sess->bodyDeps.setFileBodies(files.at(i)->getFileId(), std::move(bodies.at(i)));
+        }
 
         return {dt::None, extractSuggestions()};
     }
 
-    void NameResolver::visit(const ast::FileModule & fileModule) {
-        for (const auto & item : fileModule.getFile()->items) {
+    dt::SuggResult<dt::none_t> NameResolver::resolveIncremental(
+        const sess::sess_ptr & sess,
+        const ast::Party & party,
+        const std::unordered_set<span::file_id_t> & changedFiles
+    ) {
+        this->sess = sess;
+        rootMod = sess->modTreeRoot.unwrap();
+        pathResolver.reset(rootMod);
+
+        // Usually a few bodies are re-resolved, so it is done sequentially and right into the session storage
+        resOut = &sess->resStorage;
+
+        std::vector<const ast::FileModule*> files;
+        collectFiles(*party.getRootModule(), files);
+
+        // Files removed from party
+        std::unordered_set<span::file_id_t> liveFiles;
+        for (const auto & file : files) {
+            liveFiles.insert(file->getFileId());
+        }
+        for (const auto fileId : sess->bodyDeps.getFileIds()) {
+            if (liveFiles.find(fileId) == liveFiles.end()) {
+                for (const auto & body : sess->bodyDeps.getFileBodies(fileId)) {
+                    dropBody(body);
+                }
+                sess->bodyDeps.eraseFile(fileId);
+            }
+        }
+
+        std::vector<BodyRecord> reresolved;
+        for (const auto & file : files) {
+            const auto fileId = file->getFileId();
+            const bool changed = changedFiles.find(fileId) != changedFiles.end() or not sess->bodyDeps.hasFile(fileId);
+            auto & bodies = sess->bodyDeps.getFileBodies(fileId);
+
+            if (changed) {
+                for (const auto & body : bodies) {
+                    dropBody(body);
+                }
+                resolveFile(*file);
+                bodies = std::move(fileBodies);
+                reresolved.insert(reresolved.end(), bodies.begin(), bodies.end());
+                fileBodies.clear();
+                continue;
+            }
+
+            std::unordered_set<node_id> stale;
+            for (const auto & body : bodies) {
+                if (isStale(body)) {
+                    stale.insert(body.bodyId);
+                    dropBody(body);
+                }
+            }
+            if (stale.empty()) {
+                continue;
+            }
+
+            resolveFile(*file, &stale);
+
+            // Re-resolved bodies come in order of items, as the recorded ones do
+            auto fresh = fileBodies.begin();
+            for (auto & body : bodies) {
+                if (fresh != fileBodies.end() and body.bodyId == fresh->bodyId) {
+                    body = std::move(*fresh++);
+                    reresolved.push_back(body);
+                }
+            }
+            fileBodies.clear();
+        }
+
+        sess->resStorage.buildUses();
+        for (const auto & body : reresolved) {
+            lintUnusedLocals(body);
+        }
+
+        log.dev("Re-resolved", reresolved.size(), "of", sess->bodyDeps.bodiesCount(), "bodies");
+        logFilterStats(pathResolver.getFilterStats());
+
+        resOut = nullptr;
+        return {dt::None, extractSuggestions()};
+    }
+
+    void NameResolver::collectFiles(const ast::Module & module, std::vector<const ast::FileModule*> & files) {
+        switch (module.kind) {
+            case ast::Module::Kind::File: {
+                files.push_back(static_cast<const ast::FileModule*>(&module));
+                break;
+            }
+            case ast::Module::Kind::Dir: {
+                for (const auto & nested : static_cast<const ast::DirModule&>(module).getModules()) {
+                    collectFiles(*nested, files);
+                }
+                break;
+            }
+            case ast::Module::Kind::Root: {
+                const auto & rootModule = static_cast<const ast::RootModule&>(module);
+                collectFiles(*rootModule.getRootFile(), files);
+                collectFiles(*rootModule.getRootDir(), files);
+                break;
+            }
+        }
+    }
+
+    void NameResolver::resolveFile(const ast::FileModule & fileModule, const std::unordered_set<node_id> * onlyBodies) {
+        scopes.clear();
+        curMod = sess->fileModules.at(fileModule.getFileId());
+
+        // Top-level items of file are bodies, the unit of incremental re-resolution
+        const auto & items = fileModule.getFile()->items;
+        enterRib(); // -> (file items)
+        const auto suggestionsCount = getSuggestionsCount();
+        declareItems(items);
+        if (onlyBodies) {
+            // Redeclarations are already reported for unchanged file,
+            //  suggestions of files resolved before in this pass are kept
+            truncateSuggestions(suggestionsCount);
+        }
+
+        for (const auto & item : items) {
+            const auto itemId = item.unwrap()->id;
+            if (onlyBodies and onlyBodies->find(itemId) == onlyBodies->end()) {
+                continue;
+            }
+            beginBody(itemId);
             item.accept(*this);
+            endBody();
         }
+
+        exitRib(); // <- (file items)
+    }
+
+    // Dependencies //
+    void NameResolver::beginBody(node_id bodyId) {
+        fileBodies.push_back({bodyId, {}, {}, {}});
+        curBody = &fileBodies.back();
+    }
+
+    void NameResolver::endBody() {
+        auto & lookups = curBody->lookups;
+        std::sort(lookups.begin(), lookups.end());
+        lookups.erase(std::unique(lookups.begin(), lookups.end()), lookups.end());
+        curBody = nullptr;
+    }
+
+    bool NameResolver::isStale(const BodyRecord & body) {
+        for (const auto & lookup : body.lookups) {
+            const auto & mod = PathResolver::findModByPath(rootMod, lookup.modPath);
+            if (not mod) {
+                return true;
+            }
+            const auto & res = pathResolver.resolve(mod.unwrap(), lookup.global, lookup.segs, lookup.ns);
+            if ((res ? res.unwrap() : ast::NONE_NODE_ID) != lookup.res) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void NameResolver::dropBody(const BodyRecord & body) {
+        for (const auto pathId : body.paths) {
+            sess->resStorage.clearRes(pathId);
+        }
+    }
+
+    void NameResolver::visit(const ast::FileModule & fileModule) {
+        visitItems(fileModule.getFile()->items);
     }
 
     void NameResolver::visit(const ast::DirModule & dirModule) {
@@ -23,7 +234,8 @@ namespace jc::resolve {
     }
 
     void NameResolver::visit(const ast::Func & func) {
-        uint32_t prevDepth = getDepth();
+        enterRib(); // -> (signature)
+
         visitTypeParams(func.typeParams);
 
         for (const auto & param : func.params) {
@@ -35,7 +247,7 @@ namespace jc::resolve {
         }
 
         for (const auto & param : func.params) {
-            declare(param->name.unwrap()->getValue(), Name::Kind::Param, param->name.unwrap()->id);
+            declare(param->name.unwrap()->sym, Name::Kind::Param, param->name.unwrap()->id);
         }
 
         if (func.oneLineBody) {
@@ -44,42 +256,53 @@ namespace jc::resolve {
             func.body.unwrap()->accept(*this);
         }
 
-        liftToDepth(prevDepth);
+        exitRib(); // <- (signature)
     }
 
     void NameResolver::visit(const ast::Mod & mod) {
-        enterRib();
+        const auto parentMod = curMod;
+        const auto child = curMod->children.find(mod.name.unwrap()->sym);
+        if (not child) {
+            log.devPanic("NameResolver: `mod` is missing in module tree");
+        }
+        curMod = *child;
 
         visitItems(mod.items);
 
-        exitRib();
+        curMod = parentMod;
     }
 
     void NameResolver::visit(const ast::Struct & _struct) {
-        uint32_t prevDepth = getDepth();
-        visitTypeParams(_struct.typeParams);
-
         enterRib(); // -> (item rib)
 
+        visitTypeParams(_struct.typeParams);
+
         for (const auto & field : _struct.fields) {
             field->type.accept(*this);
         }
 
-        liftToDepth(prevDepth);
-    }
-
-    void NameResolver::visit(const ast::UseDecl & useDecl) {
-        resolveUseTree(useDecl.useTree);
+        exitRib(); // <- (item rib)
     }
 
-    void NameResolver::resolveUseTree(const ast::use_tree_ptr & maybeUseTree) {
-        // TODO: Everything goes harder
+    void NameResolver::visit(const ast::UseDecl &) {
+        // Note: Imports are resolved by `ImportResolver` into visible names of module before bodies resolution
     }
 
     // Statements //
     void NameResolver::visit(const ast::VarStmt & varStmt) {
-        enterRib();
-        declare(varStmt.name.unwrap()->getValue(), Name::Kind::Local, varStmt.id);
+        if (varStmt.type) {
+            varStmt.type.unwrap().accept(*this);
+        }
+
+        // Note: Assigned expression is resolved before declaration, so `let a = a` refers to the outer `a`
+        if (varStmt.assignExpr) {
+            varStmt.assignExpr.unwrap().accept(*this);
+        }
+
+        // Local is declared in the block rib, shadowing is handled by `ScopeTable`
+        const auto & name = varStmt.name.unwrap();
+        declare(name->sym, Name::Kind::Local, varStmt.id);
+        curBody->locals.push_back({varStmt.id, name->id, name->sym});
     }
 
     // Expressions //
@@ -95,10 +318,10 @@ namespace jc::resolve {
         enterRib(); // -> (lambda params)
 
         for (const auto & param : lambdaExpr.params) {
-            // TODO: Param name
             if (param->type) {
                 param->type.unwrap().accept(*this);
             }
+            declare(param->name.unwrap()->sym, Name::Kind::Param, param->name.unwrap()->id);
         }
 
         if (lambdaExpr.returnType) {
@@ -111,49 +334,99 @@ namespace jc::resolve {
     }
 
     void NameResolver::visit(const ast::PathExpr & pathExpr) {
-        // TODO: global
-
+        path_segs segs;
+        for (const auto & maybeSeg : pathExpr.segments) {
+            if (maybeSeg.isErr()) {
+                return;
+            }
+            const auto & seg = maybeSeg.unwrap();
+            switch (seg->kind) {
+                case ast::PathExprSeg::Kind::Super: {
+                    segs.push_back(PathResolver::superSym());
+                    break;
+                }
+                case ast::PathExprSeg::Kind::Self: {
+                    segs.push_back(PathResolver::selfSym());
+                    break;
+                }
+                case ast::PathExprSeg::Kind::Party: {
+                    segs.push_back(PathResolver::partySym());
+                    break;
+                }
+                case ast::PathExprSeg::Kind::Ident: {
+                    if (not seg->ident or seg->ident.unwrap().isErr()) {
+                        return;
+                    }
+                    segs.push_back(seg->ident.unwrap().unwrap()->sym);
+                    break;
+                }
+                case ast::PathExprSeg::Kind::Error: {
+                    return;
+                }
+            }
+        }
 
+        resolvePath(Namespace::Value, pathExpr.global, segs, pathExpr.id);
     }
 
     // Types //
     void NameResolver::visit(const ast::TypePath & typePath) {
-        // TODO: !!!
+        path_segs segs;
+        for (const auto & seg : typePath.segments) {
+            if (seg->name.isErr()) {
+                return;
+            }
+            segs.push_back(seg->name.unwrap()->sym);
+        }
+
+        resolvePath(Namespace::Type, typePath.global, segs, typePath.id);
     }
 
     // Extended visitors //
     void NameResolver::visitItems(const ast::item_list & members) {
         enterRib(); // -> (members)
 
+        declareItems(members);
+
+        // Then we resolve the signatures and bodies
+        // This is done here -- in NameResolver
+        for (const auto & member : members) {
+            member.accept(*this);
+        }
+
+        exitRib(); // <- (members)
+    }
+
+    void NameResolver::declareItems(const ast::item_list & members) {
         // At first we need to forward all declarations.
         // This is the work for ItemResolver.
         for (const auto & maybeMember : members) {
             const auto & member = maybeMember.unwrap();
-            std::string name;
+            span::Symbol name;
             Name::Kind kind;
             switch (member->kind) {
                 case ast::ItemKind::Func: {
-                    name = std::static_pointer_cast<ast::Func>(member)->name.unwrap()->getValue();
+                    name = std::static_pointer_cast<ast::Func>(member)->name.unwrap()->sym;
                     kind = Name::Kind::Func;
                     break;
                 }
                 case ast::ItemKind::Enum: {
-                    name = std::static_pointer_cast<ast::Enum>(member)->name.unwrap()->getValue();
+                    name = std::static_pointer_cast<ast::Enum>(member)->name.unwrap()->sym;
                     kind = Name::Kind::Enum;
                     break;
                 }
                 case ast::ItemKind::Struct: {
-                    name = std::static_pointer_cast<ast::Struct>(member)->name.unwrap()->getValue();
+                    name = std::static_pointer_cast<ast::Struct>(member)->name.unwrap()->sym;
                     kind = Name::Kind::Struct;
                     break;
                 }
                 case ast::ItemKind::TypeAlias: {
-                    name = std::static_pointer_cast<ast::TypeAlias>(member)->name.unwrap()->getValue();
+                    name = std::static_pointer_cast<ast::TypeAlias>(member)->name.unwrap()->sym;
                     kind = Name::Kind::TypeAlias;
                     break;
                 }
                 case ast::ItemKind::Trait: {
-                    name = std::static_pointer_cast<ast::Trait>(member)->name.unwrap()->getValue();
+                    name = std::static_pointer_cast<ast::Trait>(member)->name.unwrap()->sym;
                     kind = Name::Kind::Trait;
                     break;
                 }
@@ -161,14 +434,6 @@ namespace jc::resolve {
             }
             declare(name, kind, member->id);
         }
-
-        // Then we resolve the signatures and bodies
-        // This is done here -- in NameResolver
-        for (const auto & member : members) {
-            member.accept(*this);
-        }
-
-        exitRib(); // <- (members)
     }
 
     void NameResolver::visitTypeParams(const ast::opt_type_params & maybeTypeParams) {
@@ -179,7 +444,7 @@ namespace jc::resolve {
         for (const auto & typeParam : typeParams) {
             if (typeParam->kind == ast::TypeParamKind::Type) {
                 declare(
-                    std::static_pointer_cast<ast::GenericType>(typeParam)->name.unwrap()->getValue(),
+                    std::static_pointer_cast<ast::GenericType>(typeParam)->name.unwrap()->sym,
                     Name::Kind::TypeParam,
                     typeParam->id
                 );
@@ -188,7 +453,7 @@ namespace jc::resolve {
         for (const auto & typeParam : typeParams) {
             if (typeParam->kind == ast::TypeParamKind::Lifetime) {
                 declare(
-                    std::static_pointer_cast<ast::Lifetime>(typeParam)->name.unwrap()->getValue(),
+                    std::static_pointer_cast<ast::Lifetime>(typeParam)->name.unwrap()->sym,
                     Name::Kind::Lifetime,
                     typeParam->id
                 );
@@ -197,7 +462,7 @@ namespace jc::resolve {
         for (const auto & typeParam : typeParams) {
             if (typeParam->kind == ast::TypeParamKind::Const) {
                 declare(
-                    std::static_pointer_cast<ast::ConstParam>(typeParam)->name.unwrap()->getValue(),
+                    std::static_pointer_cast<ast::ConstParam>(typeParam)->name.unwrap()->sym,
                     Name::Kind::ConstParam,
                     typeParam->id
                 );
@@ -215,65 +480,148 @@ namespace jc::resolve {
     }
 
     // Ribs //
-    uint32_t NameResolver::getDepth() const {
-        return depth;
+    void NameResolver::enterRib(Rib::Kind kind) {
+        scopes.enterRib(kind);
     }
 
-    const rib_ptr & NameResolver::curRib() const {
-        try {
-            return ribStack.at(depth);
-        } catch (std::exception & e) {
-            common::Logger::devPanic("Called `NameResolver::curRib` with depth out of `ribStack` bounds:", depth);
-        }
+    void NameResolver::exitRib() {
+        scopes.exitRib();
     }
 
-    opt_rib NameResolver::ribAt(size_t d) const {
-        if (d >= ribStack.size()) {
-            return dt::None;
+    // Declarations //
+    void NameResolver::declare(span::Symbol name, Name::Kind kind, ast::node_id nodeId) {
+        const auto & redecl = scopes.declare(name, kind, nodeId);
+
+        if (redecl) {
+            suggestCannotRedeclare(
+                name.toString(),
+                Name::kindStr(kind),
+                Name::kindStr(redecl.unwrap().kind),
+                nodeId,
+                redecl.unwrap().nodeId
+            );
         }
-        return ribStack.at(d);
     }
 
-    void NameResolver::enterRib(Rib::Kind kind) {
-        ribStack.push_back(std::make_unique<Rib>(kind));
-        depth = ribStack.size() - 1;
+    // Resolution //
+    void NameResolver::setRes(node_id pathId, node_id res) {
+        if (resOut) {
+            resOut->setRes(pathId, res);
+        } else {
+            resShard.emplace_back(pathId, res);
+        }
     }
 
-    void NameResolver::exitRib() {
-        if (depth == 0) {
-            Logger::devPanic("NameResolver: Tried to exit top-level rib");
+    void NameResolver::resolvePath(Namespace ns, bool global, const path_segs & segs, node_id pathId) {
+        curBody->paths.push_back(pathId);
+
+        // Relative single-segment path can refer to local names
+        if (not global and segs.size() == 1) {
+            const auto & binding = scopes.lookup(ns, segs.at(0));
+            if (binding) {
+                setRes(pathId, binding.unwrap().nodeId);
+                return;
+            }
         }
-        depth--;
-    }
 
-    void NameResolver::liftToDepth(size_t prevDepth) {
-        if (prevDepth > depth) {
-            common::Logger::devPanic("Called `NameResolver::lifeToDepth` with `prevDepth` > `depth`");
+        // Ribs are file-local, so only module lookups are dependencies of body on other files
+        const auto & res = pathResolver.resolve(curMod, global, segs, ns);
+        curBody->lookups.push_back({curMod->path, global, ns, segs, res ? res.unwrap() : ast::NONE_NODE_ID});
+        if (res) {
+            setRes(pathId, res.unwrap());
+            return;
         }
 
-        for (size_t i = prevDepth; i < depth; i++) {
-            exitRib();
+        // Note: Primitive types are not declared anywhere yet, so only qualified type paths are reported
+        if (ns == Namespace::Type and segs.size() == 1) {
+            return;
         }
+
+        auto error = std::make_unique<sugg::MsgSugg>(
+            "Cannot find " + std::string(ns == Namespace::Type ? "type" : "value") + " `"
+                + PathResolver::pathToString(global, segs) + "` in this scope",
+            sess->nodeMap.getNodeSpan(pathId),
+            SuggKind::Error
+        );
+
+        const auto & similar = findSimilarNames(ns, global, segs);
+        if (similar.empty()) {
+            suggest(std::move(error));
+            return;
+        }
+
+        std::string help = "Did you mean ";
+        for (size_t i = 0; i < similar.size(); i++) {
+            if (i > 0) {
+                help += i + 1 == similar.size() ? " or " : ", ";
+            }
+            auto fixed = segs;
+            fixed.back() = similar.at(i);
+            help += "`" + PathResolver::pathToString(global, fixed) + "`";
+        }
+        suggestHelp(help + "?", std::move(error));
     }
 
-    // Declarations //
-    void NameResolver::declare(const std::string & name, Name::Kind kind, ast::node_id nodeId) {
-        const auto & redecl = curRib()->declare(name, kind, nodeId);
+    std::vector<span::Symbol> NameResolver::findSimilarNames(Namespace ns, bool global, const path_segs & segs) {
+        constexpr size_t MAX_SIMILAR_NAMES = 3;
 
-        if (redecl) {
-            suggestCannotRedeclare(
-                name,
-                Name::kindStr(kind),
-                redecl.unwrap()->kindStr(),
-                nodeId,
-                redecl.unwrap()->nodeId
-            );
+        // Only the last segment is corrected, so the module it is looked up in must exist
+        if (segs.size() > 1 or global) {
+            if (not PathResolver::walkModPath(rootMod, curMod, global, segs.begin(), segs.end() - 1)) {
+                return {};
+            }
+        }
+
+        const bool local = not global and segs.size() == 1;
+        std::vector<span::Symbol> similar;
+        for (const auto & candidate : sess->nameIndex.query(segs.back().toString())) {
+            // Index holds all symbols, suggest only names visible at this point
+            bool visible = local and scopes.lookup(ns, candidate.sym);
+            if (not visible) {
+                auto candidateSegs = segs;
+                candidateSegs.back() = candidate.sym;
+                visible = not PathResolver::lookup(rootMod, curMod, global, candidateSegs, ns).none();
+            }
+            if (visible) {
+                similar.push_back(candidate.sym);
+                if (similar.size() == MAX_SIMILAR_NAMES) {
+                    break;
+                }
+            }
         }
+        return similar;
     }
 
-    // Resolution //
-    void NameResolver::resolveSimplePath(const ast::simple_path_ptr & simplePath) {
-        // TODO
+    // Statistics //
+    void NameResolver::logFilterStats(const FilterStats & stats) {
+        if (stats.probes == 0) {
+            return;
+        }
+        const auto percent = [&](size_t count) {
+            return std::to_string(count * 100 / stats.probes) + "%";
+        };
+        log.dev(
+            "Module filters:", stats.probes, "probes,",
+            stats.rejected, "rejected (" + percent(stats.rejected) + "),",
+            stats.falsePositives, "false positives (" + percent(stats.falsePositives) + ")"
+        );
+    }
+
+    // Lints //
+    void NameResolver::lintUnusedLocals(const BodyRecord & body) {
+        for (const auto & local : body.locals) {
+            // Note: Names starting with `_` are unused intentionally
+            const auto & name = local.name.toString();
+            if (name.empty() or name.at(0) == '_') {
+                continue;
+            }
+            if (sess->resStorage.getUses(local.declId).empty()) {
+                suggestWarnMsg(
+                    "Unused variable `" + name + "`, prefix it with `_` if it is intentional",
+                    sess->nodeMap.getNodeSpan(local.nameId)
+                );
+            }
+        }
     }
 
     // Suggestions //
@@ -0,0 +1,155 @@
+#include "resolve/PathResolver.h"
+
+#include "utils/hash.h"
+
+namespace jc::resolve {
+    namespace {
+        template<class Map>
+        auto filteredFind(const dt::BloomFilter & filter, Map & map, span::Symbol name, FilterStats * stats) {
+            decltype(map.find(name)) found = nullptr;
+            if (not filter.mayContain(name.getId())) {
+                if (stats) {
+                    stats->probes++;
+                    stats->rejected++;
+                }
+                return found;
+            }
+            found = map.find(name);
+            if (stats) {
+                stats->probes++;
+                if (not found) {
+                    stats->falsePositives++;
+                }
+            }
+            return found;
+        }
+    }
+
+    span::Symbol PathResolver::superSym() {
+        static const auto sym = span::Symbol::intern("super");
+        return sym;
+    }
+
+    span::Symbol PathResolver::selfSym() {
+        static const auto sym = span::Symbol::intern("self");
+        return sym;
+    }
+
+    span::Symbol PathResolver::partySym() {
+        static const auto sym = span::Symbol::intern("party");
+        return sym;
+    }
+
+    opt_mod_node PathResolver::walkModPath(
+        const mod_node_ptr & root,
+        const mod_node_ptr & from,
+        bool global,
+        path_segs::const_iterator begin,
+        path_segs::const_iterator end,
+        FilterStats * stats
+    ) {
+        auto mod = global ? root : from;
+        for (auto it = begin; it != end; it++) {
+            const auto seg = *it;
+            const bool first = it == begin;
+            if (seg == partySym() or seg == selfSym()) {
+                // `party` and `self` are only allowed as the first segment
+                if (not first) {
+                    return dt::None;
+                }
+                mod = seg == partySym() ? root : from;
+            } else if (seg == superSym()) {
+                if (not mod->parent) {
+                    return dt::None;
+                }
+                mod = mod->parent.unwrap();
+            } else {
+                auto found = filteredFind(mod->visibleModsFilter, mod->visibleMods, seg, stats);
+                if (not found and first and not global) {
+                    found = filteredFind(root->visibleModsFilter, root->visibleMods, seg, stats);
+                }
+                if (not found) {
+                    return dt::None;
+                }
+                mod = *found;
+            }
+        }
+        return mod;
+    }
+
+    opt_mod_node PathResolver::findModByPath(const mod_node_ptr & root, const path_segs & path) {
+        auto mod = root;
+        for (const auto & seg : path) {
+            const auto child = mod->children.find(seg);
+            if (not child) {
+                return dt::None;
+            }
+            mod = *child;
+        }
+        return mod;
+    }
+
+    opt_node_id PathResolver::lookup(
+        const mod_node_ptr & root,
+        const mod_node_ptr & from,
+        bool global,
+        const path_segs & segs,
+        Namespace ns,
+        FilterStats * stats
+    ) {
+        if (segs.empty()) {
+            return dt::None;
+        }
+
+        const auto & mod = walkModPath(root, from, global, segs.begin(), segs.end() - 1, stats);
+        if (not mod) {
+            return dt::None;
+        }
+
+        const auto & target = mod.unwrap();
+        const auto found = filteredFind(target->getVisibleFilter(ns), target->getVisibleNS(ns), segs.back(), stats);
+        if (not found) {
+            return dt::None;
+        }
+        return *found;
+    }
+
+    std::string PathResolver::pathToString(bool global, const path_segs & segs) {
+        std::string str = global ? "::" : "";
+        for (size_t i = 0; i < segs.size(); i++) {
+            if (i > 0) {
+                str += "::";
+            }
+            str += segs.at(i).toString();
+        }
+        return str;
+    }
+
+    void PathResolver::reset(const mod_node_ptr & root) {
+        this->root = root;
+        memo.clear();
+        filterStats = {};
+    }
+
+    opt_node_id PathResolver::resolve(const mod_node_ptr & from, bool global, const path_segs & segs, Namespace ns) {
+        PathKey key{from.get(), ns, global, segs};
+        const auto & found = memo.find(key);
+        if (found != memo.end()) {
+            return found->second;
+        }
+
+        const auto res = lookup(root, from, global, segs, ns, &filterStats);
+        memo.emplace(std::move(key), res);
+        return res;
+    }
+
+    size_t PathResolver::PathKeyHash::operator()(const PathKey & key) const {
+        utils::hash::Hasher128 hasher;
+        hasher.add(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key.from)));
+        hasher.add(static_cast<uint64_t>(key.ns) << 1 | static_cast<uint64_t>(key.global));
+        for (const auto & seg : key.segs) {
+            hasher.add(static_cast<uint64_t>(seg.getId()));
+        }
+        return static_cast<size_t>(hasher.digest().low);
+    }
+}
@@ -0,0 +1,108 @@
+#include "resolve/ResStorage.h"
+
+namespace jc::resolve {
+    void ResStorage::reset(size_t nodesCount) {
+        resolutions.assign(nodesCount, ast::NONE_NODE_ID);
+        usesBuilt = false;
+        useOffsets.clear();
+        useSites.clear();
+    }
+
+    node_id ResStorage::getRes(node_id name) const {
+        const auto & res = getOptRes(name);
+        if (not res) {
+            common::Logger::devPanic("Called `ResStorage::getRes` for unresolved node", name);
+        }
+        return res.unwrap();
+    }
+
+    opt_node_id ResStorage::getOptRes(node_id name) const {
+        if (name >= resolutions.size() or resolutions[name] == ast::NONE_NODE_ID) {
+            return dt::None;
+        }
+        return resolutions[name];
+    }
+
+    void ResStorage::setRes(node_id name, node_id res) {
+        if (name >= resolutions.size()) {
+            // Nodes created after `reset` (e.g. by later stages), grow the table
+            resolutions.resize(name + 1, ast::NONE_NODE_ID);
+        }
+        resolutions[name] = res;
+        usesBuilt = false;
+    }
+
+    void ResStorage::clearRes(node_id name) {
+        if (name < resolutions.size()) {
+            resolutions[name] = ast::NONE_NODE_ID;
+            usesBuilt = false;
+        }
+    }
+
+    size_t ResStorage::resolvedCount() const {
+        size_t count = 0;
+        for (const auto res : resolutions) {
+            if (res != ast::NONE_NODE_ID) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    void ResStorage::merge(const res_shard & shard) {
+        // Path may be re-resolved inside one shard, so overlap is checked before any resolution of shard is set
+        for (const auto & entry : shard) {
+            if (getOptRes(entry.first)) {
+                common::Logger::devPanic("Overlapping `ResStorage` shards merged, node", entry.first, "resolved twice");
+            }
+        }
+        for (const auto & entry : shard) {
+            setRes(entry.first, entry.second);
+        }
+    }
+
+    void ResStorage::buildUses() {
+        // Definitions are nodes too, so node ids count bounds both dimensions
+        const auto nodesCount = resolutions.size();
+        size_t defsCount = nodesCount;
+        for (const auto res : resolutions) {
+            if (res != ast::NONE_NODE_ID and res >= defsCount) {
+                defsCount = res + 1;
+            }
+        }
+
+        // Count use-sites of each definition, then turn counts into offsets by prefix sum
+        useOffsets.assign(defsCount + 1, 0);
+        for (const auto res : resolutions) {
+            if (res != ast::NONE_NODE_ID) {
+                useOffsets[res + 1]++;
+            }
+        }
+        for (size_t i = 1; i <= defsCount; i++) {
+            useOffsets[i] += useOffsets[i - 1];
+        }
+
+        // Scatter use-sites, iteration by increasing name id keeps use-sites of each definition sorted
+        useSites.assign(useOffsets.back(), ast::NONE_NODE_ID);
+        std::vector<uint32_t> cursors(useOffsets.begin(), useOffsets.end() - 1);
+        for (node_id name = 0; name < nodesCount; name++) {
+            const auto res = resolutions[name];
+            if (res != ast::NONE_NODE_ID) {
+                useSites[cursors[res]++] = name;
+            }
+        }
+
+        usesBuilt = true;
+    }
+
+    ResStorage::UseRange ResStorage::getUses(node_id def) const {
+        if (not usesBuilt) {
+            common::Logger::devPanic("Called `ResStorage::getUses` before `ResStorage::buildUses`");
+        }
+        if (def + 1 >= useOffsets.size()) {
+            return {nullptr, nullptr};
+        }
+        const auto * data = useSites.data();
+        return {data + useOffsets[def], data + useOffsets[def + 1]};
+    }
+}
@@ -2,59 +2,121 @@
 
 namespace jc::sess {
     file_id_t SourceMap::addSource(const fs::path & path) {
-        file_id_t fileId = utils::hash::hash(path.string());
+        const auto & found = pathIds.find(path.string());
+        if (found != pathIds.end()) {
+            return found->second;
+        }
+
+        if (sources.size() >= UINT32_MAX) {
+            common::Logger::devPanic("Source files count exceeded in `SourceMap::addSource`");
+        }
+        const auto fileId = static_cast<file_id_t>(sources.size());
         common::Logger::devDebug("Add source", path, "with fileId", fileId);
-        sources.emplace(fileId, SourceFile(path));
+        sources.emplace_back(path);
+        pathIds.emplace(path.string(), fileId);
         return fileId;
     }
 
-    void SourceMap::setSrc(file_id_t fileId, std::string && src) {
-        if (sources.find(fileId) == sources.end()) {
-            common::Logger::devPanic(
-                "No source found by fileId",
-                fileId,
-                "in SourceMap::setSource, existent files:",
-                utils::map::keys(sources));
+    void SourceMap::setSrc(
+        file_id_t fileId,
+        std::shared_ptr<const std::string> src,
+        const utils::hash::Hash128 & contentHash
+    ) {
+        auto & sourceFile = getSourceFileMut(fileId);
+        sourceFile.contentHash = contentHash;
+        sourceFile.mapping.reset();
+        sourceFile.owned = std::move(src);
+        sourceFile.src = std::string_view(*sourceFile.owned);
+        sourceFile.lines.clear();
+        sourceFile.linesSet = false;
+    }
+
+    void SourceMap::setMappedSrc(
+        file_id_t fileId,
+        std::unique_ptr<fs::MappedFile> && mapping,
+        const utils::hash::Hash128 & contentHash
+    ) {
+        auto & sourceFile = getSourceFileMut(fileId);
+        sourceFile.contentHash = contentHash;
+        sourceFile.owned.reset();
+        sourceFile.mapping = std::move(mapping);
+        sourceFile.src = std::string_view(
+            reinterpret_cast<const char*>(sourceFile.mapping->data()),
+            sourceFile.mapping->size()
+        );
+        sourceFile.lines.clear();
+        sourceFile.linesSet = false;
+    }
+
+    void SourceMap::setLines(const SourceFile & sourceFile) {
+        const auto & src = sourceFile.src.unwrap("`SourceMap::setLines`");
+        sourceFile.lines.clear();
+        sourceFile.lines.push_back(0);
+        for (size_t i = 0; i < src.size(); i++) {
+            if (src[i] == '\n') {
+                sourceFile.lines.push_back(static_cast<line_pos_t>(i + 1));
+            }
         }
-        sources.at(fileId).src = std::move(src);
-        common::Logger::devDebug("Set source lines for file", sources.at(fileId).path, "by fileId:", fileId);
+        sourceFile.linesSet = true;
+        common::Logger::devDebug("Set source lines for file", sourceFile.path);
     }
 
     const SourceFile & SourceMap::getSourceFile(file_id_t fileId) const {
-        if (sources.find(fileId) == sources.end()) {
+        if (fileId >= sources.size()) {
             common::Logger::devPanic("No source found by fileId", fileId, "in `SourceMap::getSourceFile`");
         }
-        return sources.at(fileId);
+        return sources[fileId];
+    }
+
+    SourceFile & SourceMap::getSourceFileMut(file_id_t fileId) {
+        if (fileId >= sources.size()) {
+            common::Logger::devPanic("No source found by fileId", fileId, "in `SourceMap::setSrc`");
+        }
+        return sources[fileId];
+    }
+
+    const std::deque<SourceFile> & SourceMap::getSources() const {
+        return sources;
     }
 
     size_t SourceMap::getLinesCount(file_id_t fileId) const {
-        return getSourceFile(fileId).lines.size();
+        return getLines(fileId).size();
     }
 
-    std::string SourceMap::getLine(file_id_t fileId, size_t index) const {
+    const std::vector<line_pos_t> & SourceMap::getLines(file_id_t fileId) const {
         const auto & sf = getSourceFile(fileId);
-        if (sf.lines.size() <= index) {
+        if (not sf.linesSet) {
+            setLines(sf);
+        }
+        return sf.lines;
+    }
+
+    std::string SourceMap::getLine(file_id_t fileId, size_t index) const {
+        const auto & lines = getLines(fileId);
+        if (lines.size() <= index) {
             common::Logger::devPanic("Got too distant index of line [", index, "] in `SourceMap::getLine`");
         }
-        size_t end = sf.lines.size();
-        if (index < sf.lines.size() - 1 ){
-            sf.lines.at(index + 1);
+        const auto & src = getSourceFile(fileId).src.unwrap("`SourceMap::getLine`");
+        size_t end = src.size();
+        if (index < lines.size() - 1) {
+            end = lines.at(index + 1);
         }
-        const auto & line = sf.src.unwrap().substr(sf.lines.at(index), end);
-        return line;
+        return std::string(src.substr(lines.at(index), end - lines.at(index)));
     }
 
-    std::string SourceMap::sliceBySpan(file_id_t fileId, const span::Span & span) {
-        const auto & sourceIt = sources.find(fileId);
-        if (sourceIt == sources.end()) {
-            // FIXME: Remove
-            for (const auto & id : utils::map::keys(sources)) {
-                common::Logger::devDebug("got fileId:", id);
-            }
-            common::Logger::devPanic("Got invalid fileId in SourceMap::sliceBySpan: ", span.fileId);
+    size_t SourceMap::getLineIndex(file_id_t fileId, span::span_pos_t pos) const {
+        const auto & lines = getLines(fileId);
+        const auto & next = std::upper_bound(lines.begin(), lines.end(), pos);
+        if (next == lines.begin()) {
+            return 0;
         }
+        return static_cast<size_t>(std::distance(lines.begin(), next) - 1);
+    }
 
-        const auto & src = sourceIt->second.src;
-        return src->substr(span.pos, span.len);
+    std::string SourceMap::sliceBySpan(file_id_t fileId, const span::Span & span) {
+        if (fileId >= sources.size()) {
+            common::Logger::devPanic("Got invalid fileId in SourceMap::sliceBySpan: ", span.getFileId());
+        }
+        return std::string(sources[fileId].src.unwrap().substr(span.getPos(), span.getLen()));
     }
 }
\ No newline at end of file
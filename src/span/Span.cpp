@@ -0,0 +1,67 @@
+#include "span/Span.h"
+
+namespace jc::span {
+    Span::Span(span_pos_t pos, span_len_t len, file_id_t fileId) {
+        if (len <= INLINE_LEN_MAX and fileId <= INLINE_FILE_ID_MAX) {
+            base = pos;
+            this->len = static_cast<uint16_t>(len);
+            ctx = static_cast<uint16_t>(fileId);
+            return;
+        }
+        base = SpanInterner::getInstance().intern({pos, len, fileId});
+        ctx = INTERNED_TAG;
+    }
+
+    span_pos_t Span::getPos() const {
+        if (isInterned()) {
+            return SpanInterner::getInstance().get(base).pos;
+        }
+        return base;
+    }
+
+    span_len_t Span::getLen() const {
+        if (isInterned()) {
+            return SpanInterner::getInstance().get(base).len;
+        }
+        return len;
+    }
+
+    file_id_t Span::getFileId() const {
+        if (isInterned()) {
+            return SpanInterner::getInstance().get(base).fileId;
+        }
+        return ctx;
+    }
+
+    // SpanInterner //
+    uint32_t SpanInterner::intern(const SpanData & data) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Note: Key is a mix of all span data, collisions are resolved by linear check.
+        //  `len` must be a part of the key, otherwise long chains of spans starting at the same position are quadratic.
+        const auto key = ((static_cast<uint64_t>(data.fileId) << 32) | data.pos)
+            ^ (static_cast<uint64_t>(data.len) * 0x9E3779B97F4A7C15ULL);
+        auto & candidates = lookup[key];
+        for (const auto index : candidates) {
+            const auto & span = spans.at(index);
+            if (span.pos == data.pos and span.len == data.len and span.fileId == data.fileId) {
+                return index;
+            }
+        }
+
+        const auto index = static_cast<uint32_t>(spans.size());
+        spans.push_back(data);
+        candidates.push_back(index);
+        return index;
+    }
+
+    SpanData SpanInterner::get(uint32_t index) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return spans.at(index);
+    }
+
+    size_t SpanInterner::size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return spans.size();
+    }
+}
@@ -0,0 +1,41 @@
+#include "span/Symbol.h"
+
+namespace jc::span {
+    Symbol Symbol::intern(const std::string & str) {
+        return Symbol(Interner::getInstance().intern(str));
+    }
+
+    const std::string & Symbol::toString() const {
+        return Interner::getInstance().get(id);
+    }
+
+    // Interner //
+    Interner::Interner() {
+        // Symbol with id `0` is an empty string, thus default `Symbol` is valid
+        intern("");
+    }
+
+    sym_id_t Interner::intern(const std::string & str) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const auto & found = symbols.find(str);
+        if (found != symbols.end()) {
+            return found->second;
+        }
+
+        const auto id = static_cast<sym_id_t>(strings.size());
+        strings.push_back(str);
+        symbols.emplace(str, id);
+        return id;
+    }
+
+    const std::string & Interner::get(sym_id_t id) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return strings.at(id);
+    }
+
+    size_t Interner::size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return strings.size();
+    }
+}
@@ -24,4 +24,14 @@ namespace jc::sugg {
     void SuggInterface::suggestHelp(const std::string & helpMsg, sugg::sugg_ptr sugg) {
         suggest(std::make_unique<sugg::HelpSugg>(helpMsg, std::move(sugg)));
     }
+
+    size_t SuggInterface::getSuggestionsCount() const {
+        return suggestions.size();
+    }
+
+    void SuggInterface::truncateSuggestions(size_t count) {
+        if (count < suggestions.size()) {
+            suggestions.resize(count);
+        }
+    }
 }
@@ -46,18 +46,20 @@ namespace jc::sugg {
     }
 
     void Suggester::pointMsgTo(const std::string & msg, const Span & span) {
-        const auto & fileId = span.fileId;
+        const auto & fileId = span.getFileId();
         const auto & indent = getFileIndent(fileId);
+        const auto & lineIndex = sess->sourceMap.getLineIndex(fileId, span.getPos());
         // TODO!: Maybe not printing previous line if it's empty?
 //        printPrevLine(fileId, span.line);
-        printLine(fileId, span);
+        printLine(fileId, lineIndex);
 
-        const auto & point = span.col;
+        const size_t point = span.getPos() - sess->sourceMap.getLines(fileId).at(lineIndex);
+        const size_t spanLen = span.getLen();
         const auto & msgLen = msg.size();
 
         // Note: We add 4 because we want to put 4 additional `---^` or `^---` for readability
         const auto & realMsgLen = msgLen + 4;
-        const auto & spanMax = point + span.len; // The max point of span
+        const auto & spanMax = point + spanLen; // The max point of span
 
         if (realMsgLen <= point) {
             // We can put message before `---^`
@@ -65,14 +67,14 @@ namespace jc::sugg {
             // Here we put our message before `^` and fill empty space with `-`
             std::string pointLine = utils::str::padStart(msg, point - 3, ' ');
             pointLine += "---";
-            pointLine += utils::str::repeat("^", span.len);
+            pointLine += utils::str::repeat("^", spanLen);
 
             // We don't need to write additional `-` after `^`, so just print it
             printWithIndent(fileId, utils::str::clipStart(pointLine, wrapLen - indent.size() - 7, ""));
         } else if (wrapLen > spanMax and wrapLen - spanMax >= realMsgLen) {
             // We can put message after `^--`, because it fits space after span
 
-            std::string pointLine = utils::str::repeat(" ", point) + utils::str::repeat("^", span.len);
+            std::string pointLine = utils::str::repeat(" ", point) + utils::str::repeat("^", spanLen);
             pointLine += "---";
             pointLine += msg;
             printWithIndent(fileId, pointLine);
@@ -88,21 +90,18 @@ namespace jc::sugg {
                 formattedMsg = utils::str::hardWrap(msg, wrapLen);
             }
 
-            printWithIndent(fileId, utils::str::pointLine(pointLineLen, point, span.len));
+            printWithIndent(fileId, utils::str::pointLine(pointLineLen, point, spanLen));
             printWithIndent(fileId, formattedMsg);
         }
     }
 
-    void Suggester::printLine(file_id_t fileId, const Span & span) {
-        const auto & src = sess->sourceMap.getSourceFile(fileId).src;
-        const auto & slice = src->substr(span.pos, span.len);
-        const auto & lines = utils::str::split(slice, "\n");
-
+    void Suggester::printLine(file_id_t fileId, size_t index) {
+        const auto & line = sess->sourceMap.getLine(fileId, index);
 
         // Print indent according to line number
         // FIXME: uint overflow can appear
         const auto & indent = getFileIndent(fileId);
-        Logger::print(utils::str::repeat(" ", indent.size() - std::to_string(index).size() - 3));
+        Logger::print(utils::str::repeat(" ", indent.size() - std::to_string(index + 1).size() - 3));
         Logger::print(index + 1, "|", utils::str::clipStart(utils::str::trimEnd(line, '\n'), wrapLen - indent.size()));
         Logger::nl();
     }
@@ -0,0 +1,176 @@
+#include "utils/hash.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define JACY_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace jc::utils::hash {
+    namespace {
+        constexpr size_t STRIPE_LEN = 64;
+        constexpr size_t ACC_LANES = 8;
+        constexpr size_t SECRET_LEN = 192;
+        // Key advances by 8 bytes per stripe, accumulators are scrambled when it reaches the end of secret
+        constexpr size_t STRIPES_PER_BLOCK = (SECRET_LEN - STRIPE_LEN) / 8;
+        constexpr size_t BLOCK_LEN = STRIPE_LEN * STRIPES_PER_BLOCK;
+        // Shorter inputs are hashed by `Hasher128`, setting up lanes is not worth it
+        constexpr size_t MIN_LANES_LEN = 4 * STRIPE_LEN;
+
+        constexpr uint64_t PRIME32_1 = 0x9E3779B1ULL;
+        constexpr uint64_t PRIME32_2 = 0x85EBCA77ULL;
+        constexpr uint64_t PRIME32_3 = 0xC2B2AE3DULL;
+        constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+        constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+        struct Secret {
+            alignas(16) uint8_t bytes[SECRET_LEN];
+
+            Secret() {
+                // Fixed splitmix64 sequence, hashes are persisted so they must not change between runs
+                uint64_t state = PRIME64_5;
+                for (size_t i = 0; i < SECRET_LEN; i += sizeof(uint64_t)) {
+                    state += 0x9E3779B97F4A7C15ULL;
+                    uint64_t z = state;
+                    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                    z ^= z >> 31;
+                    std::memcpy(bytes + i, &z, sizeof(z));
+                }
+            }
+        };
+
+        const uint8_t * secret() {
+            static const Secret secret;
+            return secret.bytes;
+        }
+
+        uint64_t read64(const uint8_t * ptr) {
+            uint64_t value;
+            std::memcpy(&value, ptr, sizeof(value));
+            return value;
+        }
+
+        void accumulateStripe(uint64_t * acc, const uint8_t * input, const uint8_t * key) {
+#ifdef JACY_HASH_SSE2
+            auto * accVec = reinterpret_cast<__m128i*>(acc);
+            const auto * inputVec = reinterpret_cast<const __m128i*>(input);
+            const auto * keyVec = reinterpret_cast<const __m128i*>(key);
+            for (size_t i = 0; i < ACC_LANES / 2; i++) {
+                const auto data = _mm_loadu_si128(inputVec + i);
+                const auto keyed = _mm_xor_si128(data, _mm_loadu_si128(keyVec + i));
+                // Product of low and high 32-bit halves of each 64-bit lane
+                const auto product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+                // Input is added to the neighbour lane, so it is not lost if product is zero
+                const auto swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                accVec[i] = _mm_add_epi64(accVec[i], _mm_add_epi64(product, swapped));
+            }
+#else
+            for (size_t i = 0; i < ACC_LANES; i++) {
+                const auto data = read64(input + i * sizeof(uint64_t));
+                const auto keyed = data ^ read64(key + i * sizeof(uint64_t));
+                acc[i ^ 1] += data;
+                acc[i] += (keyed & 0xFFFFFFFFULL) * (keyed >> 32);
+            }
+#endif
+        }
+
+        void scramble(uint64_t * acc, const uint8_t * key) {
+#ifdef JACY_HASH_SSE2
+            auto * accVec = reinterpret_cast<__m128i*>(acc);
+            const auto * keyVec = reinterpret_cast<const __m128i*>(key);
+            const auto prime = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+            for (size_t i = 0; i < ACC_LANES / 2; i++) {
+                auto lanes = accVec[i];
+                lanes = _mm_xor_si128(lanes, _mm_srli_epi64(lanes, 47));
+                lanes = _mm_xor_si128(lanes, _mm_loadu_si128(keyVec + i));
+                // 64-bit multiplication by 32-bit prime is built of two 32x32-bit products
+                const auto productLow = _mm_mul_epu32(lanes, prime);
+                const auto productHigh = _mm_mul_epu32(_mm_shuffle_epi32(lanes, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+                accVec[i] = _mm_add_epi64(productLow, _mm_slli_epi64(productHigh, 32));
+            }
+#else
+            for (size_t i = 0; i < ACC_LANES; i++) {
+                auto lane = acc[i];
+                lane ^= lane >> 47;
+                lane ^= read64(key + i * sizeof(uint64_t));
+                acc[i] = lane * PRIME32_1;
+            }
+#endif
+        }
+
+        /// Fold 128-bit product of `lhs` and `rhs` to 64 bits
+        uint64_t mulFold64(uint64_t lhs, uint64_t rhs) {
+#ifdef __SIZEOF_INT128__
+            // Note: `__extension__` keeps pedantic build quiet about non-standard type
+            __extension__ typedef unsigned __int128 uint128_t;
+            const auto product = static_cast<uint128_t>(lhs) * rhs;
+            return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+            const uint64_t lowLow = (lhs & 0xFFFFFFFFULL) * (rhs & 0xFFFFFFFFULL);
+            const uint64_t highLow = (lhs >> 32) * (rhs & 0xFFFFFFFFULL);
+            const uint64_t lowHigh = (lhs & 0xFFFFFFFFULL) * (rhs >> 32);
+            const uint64_t highHigh = (lhs >> 32) * (rhs >> 32);
+            const uint64_t cross = (lowLow >> 32) + (highLow & 0xFFFFFFFFULL) + lowHigh;
+            const uint64_t upper = (highLow >> 32) + (cross >> 32) + highHigh;
+            const uint64_t lower = (cross << 32) | (lowLow & 0xFFFFFFFFULL);
+            return lower ^ upper;
+#endif
+        }
+
+        uint64_t avalanche(uint64_t h) {
+            h ^= h >> 37;
+            h *= 0x165667919E3779F9ULL;
+            h ^= h >> 32;
+            return h;
+        }
+
+        uint64_t mergeLanes(const uint64_t * acc, const uint8_t * key, uint64_t start) {
+            uint64_t result = start;
+            for (size_t i = 0; i < ACC_LANES / 2; i++) {
+                result += mulFold64(
+                    acc[2 * i] ^ read64(key + 16 * i),
+                    acc[2 * i + 1] ^ read64(key + 16 * i + 8)
+                );
+            }
+            return avalanche(result);
+        }
+    }
+
+    Hash128 contentHash(std::string_view data) {
+        const auto len = data.size();
+        if (len < MIN_LANES_LEN) {
+            return Hasher128(len).add(data).digest();
+        }
+
+        const auto * input = reinterpret_cast<const uint8_t*>(data.data());
+        const auto * key = secret();
+        alignas(16) uint64_t acc[ACC_LANES] = {
+            PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1,
+        };
+
+        const size_t blocks = (len - 1) / BLOCK_LEN;
+        for (size_t block = 0; block < blocks; block++) {
+            const auto * blockInput = input + block * BLOCK_LEN;
+            for (size_t stripe = 0; stripe < STRIPES_PER_BLOCK; stripe++) {
+                accumulateStripe(acc, blockInput + stripe * STRIPE_LEN, key + stripe * 8);
+            }
+            scramble(acc, key + SECRET_LEN - STRIPE_LEN);
+        }
+
+        // Stripes of the last partial block, then the last stripe, which may overlap the previous one
+        const auto * lastBlock = input + blocks * BLOCK_LEN;
+        const size_t stripes = (len - 1 - blocks * BLOCK_LEN) / STRIPE_LEN;
+        for (size_t stripe = 0; stripe < stripes; stripe++) {
+            accumulateStripe(acc, lastBlock + stripe * STRIPE_LEN, key + stripe * 8);
+        }
+        accumulateStripe(acc, input + len - STRIPE_LEN, key + SECRET_LEN - STRIPE_LEN - 7);
+
+        return {
+            mergeLanes(acc, key + 11, len * PRIME64_1),
+            mergeLanes(acc, key + SECRET_LEN - STRIPE_LEN - 11, ~(len * PRIME64_2)),
+        };
+    }
+}
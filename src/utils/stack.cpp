@@ -0,0 +1,89 @@
+#include "utils/stack.h"
+
+#include <exception>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define JACY_STACK_PTHREAD 1
+#else
+#define JACY_STACK_PTHREAD 0
+#endif
+
+namespace jc::utils::stack {
+    // Lowest usable address of current thread stack, `0` if not yet known
+    static thread_local uintptr_t stackLow{0};
+
+    static uintptr_t getStackLow() {
+        #if defined(__APPLE__)
+        const auto self = pthread_self();
+        return reinterpret_cast<uintptr_t>(pthread_get_stackaddr_np(self)) - pthread_get_stacksize_np(self);
+        #elif JACY_STACK_PTHREAD
+        pthread_attr_t attr;
+        if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+            return 0;
+        }
+        void * addr = nullptr;
+        size_t size = 0;
+        pthread_attr_getstack(&attr, &addr, &size);
+        pthread_attr_destroy(&attr);
+        return reinterpret_cast<uintptr_t>(addr);
+        #else
+        return 0;
+        #endif
+    }
+
+    size_t remaining() {
+        if (stackLow == 0) {
+            stackLow = getStackLow();
+            if (stackLow == 0) {
+                return SIZE_MAX;
+            }
+        }
+        const char marker{0};
+        const auto current = reinterpret_cast<uintptr_t>(&marker);
+        return current > stackLow ? current - stackLow : 0;
+    }
+
+    #if JACY_STACK_PTHREAD
+    struct Segment {
+        const std::function<void()> & cb;
+        std::exception_ptr error;
+    };
+
+    static void * runSegment(void * arg) {
+        auto segment = static_cast<Segment*>(arg);
+        try {
+            segment->cb();
+        } catch (...) {
+            segment->error = std::current_exception();
+        }
+        return nullptr;
+    }
+    #endif
+
+    void runOnNewSegment(const std::function<void()> & cb) {
+        #if JACY_STACK_PTHREAD
+        Segment segment{cb, nullptr};
+
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, SEGMENT_SIZE);
+
+        pthread_t thread;
+        const auto failed = pthread_create(&thread, &attr, runSegment, &segment);
+        pthread_attr_destroy(&attr);
+        if (failed) {
+            // Cannot allocate new segment, the best we can do is to continue on current stack
+            cb();
+            return;
+        }
+        pthread_join(thread, nullptr);
+
+        if (segment.error) {
+            std::rethrow_exception(segment.error);
+        }
+        #else
+        cb();
+        #endif
+    }
+}
@@ -0,0 +1,61 @@
+#include "utils/thread.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jc::utils::thread {
+    void parallelFor(size_t workers, size_t tasksCount, const task_func & func) {
+        if (workers > tasksCount) {
+            workers = tasksCount;
+        }
+
+        if (workers <= 1) {
+            for (size_t task = 0; task < tasksCount; task++) {
+                func(0, task);
+            }
+            return;
+        }
+
+        std::atomic<size_t> nextTask{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        auto work = [&](size_t worker) {
+            while (true) {
+                const auto task = nextTask.fetch_add(1);
+                if (task >= tasksCount) {
+                    return;
+                }
+                try {
+                    func(worker, task);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (not error) {
+                        error = std::current_exception();
+                    }
+                    // Stop handing out tasks, running ones finish
+                    nextTask.store(tasksCount);
+                    return;
+                }
+            }
+        };
+
+        // Calling thread is the worker `0`
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (size_t worker = 1; worker < workers; worker++) {
+            threads.emplace_back(work, worker);
+        }
+        work(0);
+        for (auto & thread : threads) {
+            thread.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
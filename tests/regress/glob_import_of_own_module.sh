@@ -0,0 +1,10 @@
+#!/usr/bin/env bash
+# Glob import of module own names (`use self::*`) must not modify names of module while they are imported
+
+. "$(dirname "$0")/lib.sh"
+
+printf 'mod a {\n    func f1() {}\n    func f2() {}\n    func f3() {}\n    func f4() {}\n    func f5() {}\n    func f6() {}\n    use self::*\n}\nfunc main() {\n    a::f1();\n    a::f6();\n}\n' > main.jc
+
+"$JACY" main.jc > out.txt 2>&1 || fail "Compilation failed: $(plain out.txt | grep -i "error\|panic" | head -1)"
+plain out.txt | grep -q -- "---" && fail "Unexpected diagnostics: $(plain out.txt | grep -- "---" | head -1)"
+echo "OK"
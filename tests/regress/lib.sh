@@ -0,0 +1,30 @@
+# Helpers of regression cases, each case is a script taking path to Jacy binary as the first argument
+
+JACY="$(realpath "${1:?Usage: $0 <path to Jacy binary>}")"
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORK_DIR"' EXIT
+cd "$WORK_DIR" || exit 1
+
+fail() {
+    echo "FAIL: $*"
+    exit 1
+}
+
+# Output without colors
+plain() {
+    sed 's/\x1b\[[0-9;]*m//g' "$@"
+}
+
+# Run `--watch` on `main.jc` in background until `stopWatch`, output goes to `watch.out`
+startWatch() {
+    "$JACY" main.jc --watch "$@" > watch.out 2>&1 &
+    WATCH_PID=$!
+    sleep 1
+}
+
+# Wait for watch iteration to finish and stop watcher
+stopWatch() {
+    sleep 1
+    kill "$WATCH_PID" 2> /dev/null
+    wait "$WATCH_PID" 2> /dev/null
+}
@@ -0,0 +1,19 @@
+#!/usr/bin/env bash
+# Tree manifest must be reused when root file is given without directory, e.g. `Jacy main.jc`
+
+. "$(dirname "$0")/lib.sh"
+
+mkdir sub
+printf 'func main(x: int) { x }\n' > main.jc
+printf 'func f(x: int) { x }\n' > a.jc
+printf 'func g(x: int) { x }\n' > sub/b.jc
+# Entries changed right before the walk are not trusted by the next one
+touch -d "1 minute ago" main.jc a.jc sub/b.jc sub .
+
+"$JACY" main.jc --cache -benchmark=each-stage > first.out 2>&1 || fail "First run failed"
+"$JACY" main.jc --cache -benchmark=each-stage > second.out 2>&1 || fail "Second run failed"
+
+STATS="$(plain second.out | grep "Tree manifest:")"
+echo "$STATS" | grep -q " [1-9][0-9]* reused" || fail "No directories reused: $STATS"
+echo "$STATS" | grep -q " [1-9][0-9]* reads skipped" || fail "No reads skipped: $STATS"
+echo "OK"
@@ -0,0 +1,16 @@
+#!/usr/bin/env bash
+# File changed right after the walk with the same size and mtime must be read again instead of reusing its hash
+
+. "$(dirname "$0")/lib.sh"
+
+printf 'func main() {}\n' > main.jc
+printf 'func aaa() {}\n' > a.jc
+
+"$JACY" main.jc --cache > first.out 2>&1 || fail "First run failed"
+cp -p a.jc a.ref
+printf 'func bbb() {}\n' > a.jc
+touch -r a.ref a.jc
+"$JACY" main.jc --cache -print=names > second.out 2>&1 || fail "Second run failed"
+
+plain second.out | grep -q "bbb" || fail "Stale content hash of changed file is reused"
+echo "OK"
@@ -0,0 +1,14 @@
+#!/usr/bin/env bash
+# Run all regression cases: tests/regress/run.sh <path to Jacy binary>
+
+DIR="$(dirname "$0")"
+FAILED=0
+for CASE in "$DIR"/*.sh; do
+    NAME="$(basename "$CASE")"
+    if [ "$NAME" = "lib.sh" ] || [ "$NAME" = "run.sh" ]; then
+        continue
+    fi
+    echo -n "$NAME: "
+    bash "$CASE" "$1" || FAILED=1
+done
+exit $FAILED
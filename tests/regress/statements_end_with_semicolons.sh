@@ -0,0 +1,10 @@
+#!/usr/bin/env bash
+# Statements ended by `;` (also before `}` and after new-line) must parse without errors
+
+. "$(dirname "$0")/lib.sh"
+
+printf 'func f(x: int) { x }\nfunc main(x: int) {\n    f(x);\n    loop { f(x); break; };\n}\n' > main.jc
+
+"$JACY" main.jc > out.txt 2>&1 || fail "Compilation failed: $(plain out.txt | grep -i "error" | head -1)"
+plain out.txt | grep -q -- "---" && fail "Unexpected diagnostics: $(plain out.txt | grep -- "---" | head -1)"
+echo "OK"
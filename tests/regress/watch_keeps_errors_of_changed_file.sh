@@ -0,0 +1,15 @@
+#!/usr/bin/env bash
+# Error in changed file must be reported when unchanged file depending on it is re-resolved after it
+
+. "$(dirname "$0")/lib.sh"
+
+printf 'use a::f\nuse b::g\nfunc main(x: int) { f(x); g(x) }\n' > main.jc
+printf 'func f(x: int) { x }\n' > a.jc
+printf 'use a::f\nfunc g(x: int) { f(x) }\n' > b.jc
+
+startWatch
+printf 'func f(x: int) { zzz }\n' > a.jc
+stopWatch
+
+plain watch.out | grep -q "Cannot find value \`zzz\`" || fail "Unresolved name in changed file is not reported"
+echo "OK"
@@ -0,0 +1,16 @@
+#!/usr/bin/env bash
+# Changed file is linted with parent index of its new nodes, e.g. enclosing loops and functions are known
+
+. "$(dirname "$0")/lib.sh"
+
+printf 'use a::f\nfunc main(x: int) { f(x) }\n' > main.jc
+printf 'func f(x: int) { x }\n' > a.jc
+
+startWatch
+printf 'func f(x: int) { loop { break; }; return x; }\nfunc g() { break; }\n' > a.jc
+stopWatch
+
+OUT="$(plain watch.out)"
+[ "$(echo "$OUT" | grep -c "\`break\` outside of loop")" = 1 ] || fail "\`break\` outside of loop is not reported once"
+echo "$OUT" | grep -q "\`return\` outside of function" && fail "\`return\` inside of function is reported"
+echo "OK"
@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+# Change of file must be noticed when its event is lost on inotify queue overflow
+
+. "$(dirname "$0")/lib.sh"
+
+printf 'use a::f\nfunc main(x: int) { f(x) }\n' > main.jc
+printf 'func f(x: int) { x }\n' > a.jc
+
+startWatch
+# Queue overflows while watcher is stopped, event of `a.jc` written after it is dropped
+kill -STOP "$WATCH_PID"
+EVENTS="$(cat /proc/sys/fs/inotify/max_queued_events)"
+for _ in $(seq 1 $((EVENTS / 2 + 1))); do
+    : > x1.txt
+    : > x2.txt
+done
+printf 'func f(x: int) { zzz }\n' > a.jc
+kill -CONT "$WATCH_PID"
+stopWatch
+
+plain watch.out | grep -q "Cannot find value \`zzz\`" || fail "Change lost on queue overflow is not compiled"
+echo "OK"
@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+# Unchanged file with parse errors must be parsed again on each iteration, so its errors are reported again
+
+. "$(dirname "$0")/lib.sh"
+
+printf 'func main(x: int) { x }\n' > main.jc
+printf '42\nfunc f(x: int) { x }\n' > a.jc
+printf 'func g(x: int) { x }\n' > b.jc
+
+startWatch
+printf 'func g(x: int) { x + 1 }\n' > b.jc
+stopWatch
+
+plain watch.out | grep -q "Unexpected \[ERROR\] node" && fail "Reused file with parse errors reached linter"
+[ "$(plain watch.out | grep -c "Unexpected expression on top-level")" -eq 2 ] \
+    || fail "Parse errors of unchanged file are not reported again"
+echo "OK"
@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+# Ids reserved for definitions of precompiled party must fit indices rebuilt by watch iteration
+
+. "$(dirname "$0")/lib.sh"
+
+mkdir lib app
+printf 'func helper(x: int) { x }\nfunc other(x: int) { x }\n' > lib/main.jc
+(cd lib && "$JACY" main.jc -emit-meta=../lib.meta > /dev/null 2>&1) || fail "Cannot emit module metadata"
+
+cd app || exit 1
+printf 'func main(x: int) { x }\n' > main.jc
+printf 'func f(x: int) { x }\n' > a.jc
+
+startWatch -extern=../lib.meta
+printf 'func f(x: int) { x + 1 }\n' > a.jc
+stopWatch
+
+plain watch.out | grep -q "PANIC" && fail "Watch iteration panicked: $(plain watch.out | grep PANIC)"
+plain watch.out | grep -q "Iteration 1 done" || fail "Watch iteration did not finish"
+echo "OK"